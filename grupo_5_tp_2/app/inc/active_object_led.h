@@ -43,7 +43,18 @@
 #include "task_led.h"
 
 #define MAX_LED_TASKS 3
-#define LED_TASK_STACK_SIZE configMINIMAL_STACK_SIZE
+
+/* 1: LED on-durations run on pooled one-shot software timers owned by the LED AO.
+ * 0: every LED event spawns a worker task that sleeps through the on-duration. */
+#define LED_AO_CONFIG_USE_PULSE_TIMERS      (1)
+
+#define LED_AO_QUEUE_LENGTH                 (10)
+#define LED_PULSE_DURATION_MS               (1000)
+#define LED_PULSE_POOL_SIZE                 (8)
+
+/* Spawn mode: events waiting for a free worker, and how long one may wait before it is dropped */
+#define LED_PENDING_QUEUE_LENGTH            (8)
+#define LED_PENDING_MAX_WAIT_MS             (3000)
 
 /* ============================================================================================ */
 
@@ -64,13 +75,17 @@ typedef struct
 	led_color_t color;
 	led_cmd_t state ;
 	char* name;
+	uint32_t trace_id; // Latency trace correlation id of the originating button event
 } LedTask_t;
 
-/* This struct defines the pool memory for the LED tasks */
+/* Admission counters of the spawn mode pending queue */
 typedef struct
 {
-    LedTask_t tasks[MAX_LED_TASKS];
-} LedTaskPoolMemory_t;
+	uint32_t accepted;   // Events queued for a worker
+	uint32_t rejected;   // Events dropped because the pending queue was full
+	uint32_t expired;    // Events dropped after waiting more than LED_PENDING_MAX_WAIT_MS
+	uint32_t dispatched; // Events handed to a worker
+} led_admission_stats_t;
 
 /* LED events queues */
 extern QueueHandle_t led_event_queue;
@@ -79,8 +94,7 @@ extern QueueHandle_t led_event_queue;
 extern LedTask_t led_task;
 
 
-extern LedTaskPoolMemory_t led_task_pool_memory; // Memory for the LED tasks
-extern memory_pool_t led_task_pool; // Memory pool for the LED tasks
+extern memory_pool_t led_task_pool; // Recycled LED workers (TCB and stack), spawn mode only
 
 
 
@@ -95,10 +109,15 @@ extern memory_pool_t led_task_pool; // Memory pool for the LED tasks
 void led_task_init(LedTask_t *task, QueueHandle_t queue, void (*set_state)(led_cmd_t cmd));
 
 /**
- * @brief This function runs the LED task
- * @param task This is a pointer to the LED task
+ * @brief This function creates the LED active object (event queue, task and pulse timers)
+ */
+void led_ao_init(void);
+
+/**
+ * @brief This function runs the LED active object task
+ * @param argument Not used
  */
-void led_task_run(void);
+void led_task_run(void *argument);
 
 /**
  * @brief This function allocates memory for a LED task
@@ -113,13 +132,19 @@ LedTask_t *allocate_led_task(void);
 void free_led_task(LedTask_t *task);
 
 /**
- * @brief This function creates a LED task
- * @param event_queue This is the queue to receive commands
- * @param set_state This is a function pointer to set the LED state
- * @param task_name This is the name of the task
+ * @brief This function posts a LED event to the LED active object
+ * @param payload This is the LED event (color, command and name)
  */
 void create_led_task(LedTask_t payload);
 
+#if (0 == LED_AO_CONFIG_USE_PULSE_TIMERS)
+/**
+ * @brief This function copies the spawn mode admission counters
+ * @param pstats This is where the counters are copied to
+ */
+void led_admission_stats_get(led_admission_stats_t *pstats);
+#endif
+
 /**
  * @brief This function destroys a LED task
  * @param task This is a pointer to the LED task
@@ -40,8 +40,11 @@
 #include "main.h"
 #include "cmsis_os.h"
 #include "active_object_led.h"
+#include "hsm.h"
 /* ============================================================================================ */
 
+#define UI_EVENT_QUEUE_LENGTH (10)
+
 
 /* LED tasks */
 //LedTask_t red_task;
@@ -62,6 +65,7 @@ typedef struct
 {
     QueueHandle_t button_state_queue; // Queue to receive button states
     LedTask_t *led_task; // LED task
+    hsm_t hsm; // UI state machine, driven by button events
 
 } UiTask_t;
 
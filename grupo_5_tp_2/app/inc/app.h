@@ -1,80 +1,99 @@
-/*
- * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions are met:
- *
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- *
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * 3. Neither the name of the copyright holder nor the names of its
- *    contributors may be used to endorse or promote products derived from
- *    this software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
- * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
- * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
- * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
- * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
- * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
- * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
- * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
- * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- * POSSIBILITY OF SUCH DAMAGE.
- *
- * @author : Sebastian Bedin <sebabedin@gmail.com>
- */
-
-#ifndef APP_H_
-#define APP_H_
-
-/********************** CPP guard ********************************************/
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/********************** inclusions *******************************************/
-#include "main.h"
-#include "cmsis_os.h"
-#include "logger.h"
-#include "dwt.h"
-#include "board.h"
-#include "task_button.h"
-#include "active_object_led.h"
-#include "active_object_ui.h"
-/********************** macros ***********************************************/
-
-/********************** typedef **********************************************/
-
-/********************** external data declaration ****************************/
-/* UI data */
-//extern QueueHandle_t ui_event_queue;
-//extern UiTask_t ui_task;
-
-
-
-//extern QueueHandle_t led_r_event_queue;
-//extern QueueHandle_t led_g_event_queue;
-//extern QueueHandle_t led_b_event_queue;
-
-//extern LedTask_t red_task;
-//extern LedTask_t green_task;
-//extern LedTask_t blue_task;
-/********************** external functions declaration ***********************/
-void app_init(void);
-
-/********************** End of CPP guard *************************************/
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* APP_H_ */
-
-/********************** end of file ******************************************/
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @author : Sebastian Bedin <sebabedin@gmail.com>
+ */
+
+#ifndef APP_H_
+#define APP_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+#include "prof.h"
+#include "pc_sampler.h"
+#include "stack_mon.h"
+#include "board.h"
+#include "app_task_table.h"
+#include "event_bus.h"
+#include "task_button.h"
+#include "active_object_led.h"
+#include "active_object_ui.h"
+/********************** macros ***********************************************/
+
+/********************** typedef **********************************************/
+typedef struct
+{
+    const char* name;
+    uint32_t period_ms;
+    uint32_t wcet_us;
+    UBaseType_t priority;
+    uint16_t stack_words;
+    uint8_t placement;
+} app_task_config_t;
+
+
+/********************** external data declaration ****************************/
+extern const app_task_config_t app_task_config[APP_TASK__N];
+
+/* UI data */
+//extern QueueHandle_t ui_event_queue;
+//extern UiTask_t ui_task;
+
+
+
+//extern QueueHandle_t led_r_event_queue;
+//extern QueueHandle_t led_g_event_queue;
+//extern QueueHandle_t led_b_event_queue;
+
+//extern LedTask_t red_task;
+//extern LedTask_t green_task;
+//extern LedTask_t blue_task;
+/********************** external functions declaration ***********************/
+void app_init(void);
+
+BaseType_t app_task_create(app_task_id_t id, TaskFunction_t func, void* argument, TaskHandle_t* phandle);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_H_ */
+
+/********************** end of file ******************************************/
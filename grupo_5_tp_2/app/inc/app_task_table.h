@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : app_task_table.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef APP_TASK_TABLE_H_
+#define APP_TASK_TABLE_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/* No inclusions on purpose: tools/rta.c builds this table on the host */
+
+/********************** macros ***********************************************/
+
+/*
+ * Every task of the application, in one place.
+ *
+ *  id          : APP_TASK_ID_<id>
+ *  name        : FreeRTOS task name
+ *  period_ms   : period, or minimum inter-arrival time for event driven tasks (also the deadline)
+ *  wcet_us     : worst case execution time budget per release
+ *  priority    : above tskIDLE_PRIORITY, below configMAX_PRIORITIES, rate monotonic: a shorter
+ *                period never gets a lower priority, equal periods are ordered by dependency
+ *  stack_words : stack depth in StackType_t words
+ *  placement   : where the stack lives when static allocation is enabled
+ *                SRAM, CCM (core coupled RAM, no DMA access) or EXTERNAL (allocated by its owner)
+ *
+ * Run tools/rta.c after touching this table, it checks every deadline and the
+ * button to LED deadline below with a response time analysis.
+ */
+#define APP_TASK_TABLE(X)\
+/*  id,          name,           period_ms, wcet_us, priority, stack_words, placement */\
+  X(BUTTON,      "Button Task",  5,         1000,    6,        256,         SRAM)\
+  X(UI,          "UI Task",      200,       1000,    5,        256,         SRAM)\
+  X(LED,         "LED Task",     200,       500,     4,        256,         SRAM)\
+  X(TIMER_SVC,   "Tmr Svc",      200,       200,     4,        256,         EXTERNAL)\
+  X(LED_WORKER,  "LED Worker",   200,       300,     3,        256,         EXTERNAL)\
+  X(LED_REAPER,  "LED Reaper",   200,       200,     4,        256,         EXTERNAL)\
+  X(LOGGER,      "Logger",       500,       5000,    2,        384,         SRAM)\
+  X(STACK_MON,   "Stack Mon",    5000,      5000,    1,        256,         SRAM)
+
+/*
+ * BUTTON runs every BUTTON_SCAN_PERIOD_MS in scan mode, the tightest of the button modes,
+ * the EXTI and capture modes release it less often. LED_REAPER sits above LED_WORKER so
+ * a finished worker is deleted right away.
+ */
+
+/* Button release to LED on: one button period to sample the release, then button, UI and LED */
+#define APP_BUTTON_TO_LED_DEADLINE_MS           (100)
+#define APP_BUTTON_TO_LED_CHAIN(X)              X(BUTTON) X(UI) X(LED)
+
+/********************** typedef **********************************************/
+
+typedef enum
+{
+  APP_TASK_MEM_SRAM,
+  APP_TASK_MEM_CCM,
+  APP_TASK_MEM_EXTERNAL,
+} app_task_mem_t;
+
+#define APP_TASK_ID_(id, name, period_ms, wcet_us, priority, stack_words, placement) APP_TASK_ID_##id,
+typedef enum
+{
+  APP_TASK_TABLE(APP_TASK_ID_)
+  APP_TASK__N,
+} app_task_id_t;
+#undef APP_TASK_ID_
+
+#define APP_TASK_PRIO_(id, name, period_ms, wcet_us, priority, stack_words, placement) APP_TASK_PRIO_##id = (priority),
+enum
+{
+  APP_TASK_TABLE(APP_TASK_PRIO_)
+};
+#undef APP_TASK_PRIO_
+
+#define APP_TASK_STACK_(id, name, period_ms, wcet_us, priority, stack_words, placement) APP_TASK_STACK_##id = (stack_words),
+enum
+{
+  APP_TASK_TABLE(APP_TASK_STACK_)
+};
+#undef APP_TASK_STACK_
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_TASK_TABLE_H_ */
+/********************** end of file ******************************************/
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : button_scan.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef BUTTON_SCAN_H_
+#define BUTTON_SCAN_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+
+/********************** macros ***********************************************/
+
+/* Two 16 pin ports fill the 32 bit vertical counter */
+#define BUTTON_SCAN_CONFIG_MAX_PORTS    (2)
+#define BUTTON_SCAN_CONFIG_MAX_INPUTS   (32)
+
+/********************** typedef **********************************************/
+
+typedef struct
+{
+  GPIO_TypeDef* port;
+  uint16_t pin;
+  GPIO_PinState pressed;        /* Pin level while the button is pressed */
+} button_scan_input_t;
+
+typedef struct
+{
+  GPIO_TypeDef* port[BUTTON_SCAN_CONFIG_MAX_PORTS];
+  uint16_t mask[BUTTON_SCAN_CONFIG_MAX_PORTS];
+  uint32_t invert;              /* Sample bits whose button is active low */
+  size_t nports;
+  uint32_t input_bit[BUTTON_SCAN_CONFIG_MAX_INPUTS];
+  size_t ninputs;
+
+  /* 2 bit vertical counter, one bit of each counter per sample bit */
+  uint32_t cnt0;
+  uint32_t cnt1;
+  uint32_t state;               /* Debounced state, 1 is pressed */
+} button_scan_t;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+/* Returns false when the inputs span more than BUTTON_SCAN_CONFIG_MAX_PORTS ports */
+bool button_scan_init(button_scan_t* hscan, const button_scan_input_t* inputs, size_t ninputs);
+
+/* Samples every port once and returns the sample bits whose debounced state changed,
+ * a bit changes after four equal samples in a row */
+uint32_t button_scan_update(button_scan_t* hscan);
+
+static inline bool button_scan_input_changed(const button_scan_t* hscan, uint32_t changed, size_t input)
+{
+  return 0 != (changed & hscan->input_bit[input]);
+}
+
+static inline bool button_scan_input_pressed(const button_scan_t* hscan, size_t input)
+{
+  return 0 != (hscan->state & hscan->input_bit[input]);
+}
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUTTON_SCAN_H_ */
+/********************** end of file ******************************************/
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : crash_log.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef CRASH_LOG_H_
+#define CRASH_LOG_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+
+#define CRASH_LOG_CONFIG_SIZE           (2048)      /* Bytes of history, power of two */
+#define CRASH_LOG_CONFIG_RESET          (0)         /* 1: resets once sealed instead of halting */
+#define CRASH_LOG_MAGIC                 (0x474F4C43UL)  /* "CLOG" */
+#define CRASH_LOG_WHERE_LEN             (24)
+
+/********************** typedef **********************************************/
+
+typedef enum
+{
+  CRASH_LOG_REASON_NONE,
+  CRASH_LOG_REASON_ASSERT,          /* where: file, info: line */
+  CRASH_LOG_REASON_STACK_OVERFLOW,  /* where: task name */
+  CRASH_LOG_REASON_HARDFAULT,       /* info: SCB->CFSR */
+} crash_log_reason_t;
+
+/* Lives in .noinit with the history, the checksum covers both and is only valid once sealed */
+typedef struct
+{
+  uint32_t magic;
+  uint32_t size;
+  uint32_t head;                    /* Bytes written since reset, the history is the last size */
+  uint32_t reason;
+  uint32_t info;
+  char where[CRASH_LOG_WHERE_LEN];
+  char task[CRASH_LOG_WHERE_LEN];   /* Running when sealed */
+  uint32_t checksum;
+} crash_log_header_t;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+/* Keeps a sealed log left by the previous run for crash_log_dump(), resets it otherwise */
+void crash_log_init(void);
+
+/* Appends to the history with plain stores, from the log drain only. Ignored while a
+ * previous crash is pending or once sealed */
+void crash_log_write(const char* buf, size_t len);
+
+/*
+ * Crash path, interrupts get masked and never come back: flushes the messages the drain
+ * did not get to, records the reason and checksums the log. Only the first call counts.
+ */
+void crash_log_seal(crash_log_reason_t reason, const char* where, uint32_t info);
+
+/* configASSERT hook */
+void crash_log_assert(const char* file, int line);
+
+/* Header of the log sealed by the previous run, NULL if there is none */
+const crash_log_header_t* crash_log_pending(void);
+
+/* Writes the pending history, oldest first, and starts a new log */
+void crash_log_dump(void (*print)(const char* buf, size_t len));
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRASH_LOG_H_ */
+/********************** end of file ******************************************/
@@ -1,121 +1,129 @@
-/*
- * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar>.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions are met:
- *
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- *
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * 3. Neither the name of the copyright holder nor the names of its
- *    contributors may be used to endorse or promote products derived from
- *    this software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
- * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
- * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
- * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
- * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
- * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
- * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
- * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
- * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- * POSSIBILITY OF SUCH DAMAGE.
- *
- * @file   : dwt.h
- * @date   : Set 26, 2023
- * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
- * @version	v1.0.0
- */
-
-#ifndef DWT_INC_DWT_H_
-#define DWT_INC_DWT_H_
-
-/********************** CPP guard ********************************************/
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/********************** inclusions *******************************************/
-
-/********************** macros ***********************************************/
-
-/* init cycle counter */
-/* DWT (Data Watchpoint and Trace) registers, only exists on ARM Cortex with a DWT unit */
-/*!< DEMCR: Debug Exception and Monitor Control Register */
-/*!< TRCENA: Enable trace and debug block DEMCR (Debug Exception and Monitor Control Register) */
-/*!< DWT Cycle Counter register */
-/*!< CYCCNTENA bit in DWT_CONTROL register */
- #define cycle_counter_init() ({\
-	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;	/* enable DWT hardware */\
-	DWT->CYCCNT = 0;								/* reset cycle counter */\
-	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;			/* start counting */\
- 	})
-
-/* reset cycle counter */
-/*!< DWT Cycle Counter register */
-#define cycle_counter_reset() (DWT->CYCCNT = 0)
-
-/* start counting */
-/*!< CYCCNTENA bit in DWT_CONTROL register */
-#define cycle_counter_enable() (DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk)
-
-/* disable counting if not used any more */
-/*!< CYCCNTENA bit in DWT_CONTROL register */
-#define cycle_counter_disable() (~DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk)
-
-/* read cycle counter */
-/*!< DWT Cycle Counter register */
-#define cycle_counter_get() (DWT->CYCCNT)
-#define cycles_per_us (SystemCoreClock / 1000000)
-#define cycle_counter_time_us() (DWT->CYCCNT / cycles_per_us)
-
-/*  uint32_t cycle_counter = 0;
- *  uint32_t cycle_counter_time_us = 0;
- *															// PC8 (GPIO)
- *  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_8, GPIO_PIN_RESET);	// => ______
- *  cycle_counter_init();
- *
- *  ...
- *  ...														// => ______
- *																	 ___
- *  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_8, GPIO_PIN_SET); 	// => __/
- *  // or => HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_8);
- *  cycle_counter_reset();
- *																  ______
- *  ...														// =>
- *
- *  cycle_counter = cycle_counter_get();
- *  cycle_counter_time_us = cycle_counter_time_us();			  __
- *  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_8, GPIO_PIN_RESET);	// =>   \___
- *  // or => HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_8);
- *
- *  														// => ______
- *
- *  DEBUGOUT("Cycles: %lu - Time %lu uS\r\n", cycle_counter, cycle_counter_time_us);
- */
-
-/********************** macros ***********************************************/
-
-/********************** typedef **********************************************/
-
-/********************** external data declaration ****************************/
-
-/********************** external functions declaration ***********************/
-
-/********************** End of CPP guard *************************************/
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* DWT_INC_DWT_H_ */
-
-/********************** end of file ******************************************/
-
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : dwt.h
+ * @date   : Set 26, 2023
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef DWT_INC_DWT_H_
+#define DWT_INC_DWT_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+
+/********************** macros ***********************************************/
+
+/* init cycle counter */
+/* DWT (Data Watchpoint and Trace) registers, only exists on ARM Cortex with a DWT unit */
+/*!< DEMCR: Debug Exception and Monitor Control Register */
+/*!< TRCENA: Enable trace and debug block DEMCR (Debug Exception and Monitor Control Register) */
+/*!< DWT Cycle Counter register */
+/*!< CYCCNTENA bit in DWT_CONTROL register */
+ #define cycle_counter_init() ({\
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;	/* enable DWT hardware */\
+	DWT->CYCCNT = 0;								/* reset cycle counter */\
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;			/* start counting */\
+ 	})
+
+/* reset cycle counter */
+/*!< DWT Cycle Counter register */
+#define cycle_counter_reset() (DWT->CYCCNT = 0)
+
+/* start counting */
+/*!< CYCCNTENA bit in DWT_CONTROL register */
+#define cycle_counter_enable() (DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk)
+
+/* disable counting if not used any more */
+/*!< CYCCNTENA bit in DWT_CONTROL register */
+#define cycle_counter_disable() (DWT->CTRL &= ~DWT_CTRL_CYCCNTENA_Msk)
+
+/* read cycle counter */
+/*!< DWT Cycle Counter register */
+#define cycle_counter_get() (DWT->CYCCNT)
+#define cycles_per_us (SystemCoreClock / 1000000)
+#define cycle_counter_time_us() (DWT->CYCCNT / cycles_per_us)
+
+/*  uint32_t cycle_counter = 0;
+ *  uint32_t cycle_counter_time_us = 0;
+ *															// PC8 (GPIO)
+ *  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_8, GPIO_PIN_RESET);	// => ______
+ *  cycle_counter_init();
+ *
+ *  ...
+ *  ...														// => ______
+ *																	 ___
+ *  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_8, GPIO_PIN_SET); 	// => __/
+ *  // or => HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_8);
+ *  cycle_counter_reset();
+ *																  ______
+ *  ...														// =>
+ *
+ *  cycle_counter = cycle_counter_get();
+ *  cycle_counter_time_us = cycle_counter_time_us();			  __
+ *  HAL_GPIO_WritePin(GPIOC, GPIO_PIN_8, GPIO_PIN_RESET);	// =>   \___
+ *  // or => HAL_GPIO_TogglePin(GPIOC, GPIO_PIN_8);
+ *
+ *  														// => ______
+ *
+ *  DEBUGOUT("Cycles: %lu - Time %lu uS\r\n", cycle_counter, cycle_counter_time_us);
+ */
+
+/********************** macros ***********************************************/
+
+/********************** typedef **********************************************/
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+/* 64 bit cycle count, wrap safe as long as it is read at least once per CYCCNT wrap
+ * (~25.6 s at 168 MHz), vApplicationTickHook reads it every tick. Callable from tasks and
+ * ISRs. cycle_counter_init() and cycle_counter_reset() zero CYCCNT and break it: app_init()
+ * calls cycle_counter_init() first, before the scheduler and any other user */
+uint64_t cycle_counter_get64(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DWT_INC_DWT_H_ */
+
+/********************** end of file ******************************************/
+
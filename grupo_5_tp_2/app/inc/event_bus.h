@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : event_bus.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef EVENT_BUS_H_
+#define EVENT_BUS_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_os.h"
+
+/********************** macros ***********************************************/
+
+/* One bit of the 32-bit subscriber mask per queue */
+#define BUS_CONFIG_MAX_SUBSCRIBERS              (32)
+
+/********************** typedef **********************************************/
+
+/* Every subscriber of a signal must create its queue with the event type of that signal */
+typedef enum
+{
+  BUS_SIGNAL_BUTTON,    /* message_t, published by the button task */
+  BUS_SIGNAL_LED,       /* LedTask_t, published by the UI */
+  BUS_SIGNAL__N,
+} bus_signal_t;
+
+typedef struct
+{
+  uint32_t delivered;
+  uint32_t dropped;
+} bus_topic_stats_t;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+void bus_init(void);
+
+bool bus_subscribe(bus_signal_t signal, QueueHandle_t queue);
+
+uint32_t bus_publish(bus_signal_t signal, const void* pevent);
+
+void bus_stats_get(bus_signal_t signal, bus_topic_stats_t* pstats);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_BUS_H_ */
+/********************** end of file ******************************************/
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : hsm.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef HSM_H_
+#define HSM_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+
+#define HSM_STATE_NONE                          (0xFF)
+#define HSM_CONFIG_MAX_DEPTH                    (8)
+
+/* Transition table cell of state s for event e */
+#define HSM_CELL(nevents, s, e)                 (((s) * (nevents)) + (e))
+
+/********************** typedef **********************************************/
+
+typedef uint8_t hsm_state_id_t;
+typedef uint8_t hsm_event_id_t;
+
+typedef struct hsm_s hsm_t;
+
+typedef void (*hsm_action_t)(hsm_t* hsm, const void* pevent);
+typedef bool (*hsm_guard_t)(const hsm_t* hsm, const void* pevent);
+
+typedef enum
+{
+  HSM_TRAN_NONE,        /* Not handled here, the event bubbles up to the parent state */
+  HSM_TRAN_INTERNAL,    /* Runs the action without leaving the current state */
+  HSM_TRAN_EXTERNAL,    /* Runs exit actions, the action and entry actions up to the target */
+} hsm_tran_kind_t;
+
+typedef struct
+{
+  hsm_state_id_t parent;    /* HSM_STATE_NONE for a top level state */
+  hsm_state_id_t initial;   /* Child entered after this state, HSM_STATE_NONE for a leaf */
+  hsm_action_t entry;
+  hsm_action_t exit;
+  const char* name;
+} hsm_state_t;
+
+typedef struct
+{
+  hsm_tran_kind_t kind;
+  hsm_guard_t guard;        /* NULL means always enabled */
+  hsm_action_t action;
+  hsm_state_id_t target;    /* Only used by external transitions */
+} hsm_transition_t;
+
+/* Both tables are meant to be const so they stay in flash */
+typedef struct
+{
+  const hsm_state_t* states;
+  const hsm_transition_t* transitions;  /* nstates x nevents, indexed with HSM_CELL() */
+  uint8_t nstates;
+  uint8_t nevents;
+  hsm_state_id_t initial;
+} hsm_config_t;
+
+struct hsm_s
+{
+  const hsm_config_t* config;
+  hsm_state_id_t state;
+  void* context;
+};
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+void hsm_init(hsm_t* hsm, const hsm_config_t* config, void* context);
+
+bool hsm_dispatch(hsm_t* hsm, hsm_event_id_t event, const void* pevent);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HSM_H_ */
+/********************** end of file ******************************************/
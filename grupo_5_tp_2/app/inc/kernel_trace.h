@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : kernel_trace.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef KERNEL_TRACE_H_
+#define KERNEL_TRACE_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+
+#define KERNEL_TRACE_CONFIG_ENABLE      (1)
+#define KERNEL_TRACE_CONFIG_RECORDS     (1024)  /* 8 bytes each, power of two */
+#define KERNEL_TRACE_CONFIG_NAMES       (16)    /* Task names kept, by task number */
+
+#define KERNEL_TRACE_MAGIC              (0x4352544BUL)  /* "KTRC" */
+#define KERNEL_TRACE_VERSION            (1)
+#define KERNEL_TRACE_NAME_LEN           (16)
+
+#define KERNEL_TRACE_FLAG_ISR           (0x01)
+
+/********************** typedef **********************************************/
+
+typedef enum
+{
+  KERNEL_TRACE_EVENT_GAP,                   /* Nothing happened for delta cycles, longer gaps take several */
+  KERNEL_TRACE_EVENT_TASK_SWITCHED_IN,      /* object: task number */
+  KERNEL_TRACE_EVENT_TASK_SWITCHED_OUT,
+  KERNEL_TRACE_EVENT_TASK_CREATE,
+  KERNEL_TRACE_EVENT_TASK_DELETE,
+  KERNEL_TRACE_EVENT_QUEUE_CREATE,          /* object: queue number, semaphores and mutexes included */
+  KERNEL_TRACE_EVENT_QUEUE_SEND,
+  KERNEL_TRACE_EVENT_QUEUE_RECEIVE,
+  KERNEL_TRACE_EVENT_QUEUE_BLOCK_SEND,      /* The running task blocks on a full queue */
+  KERNEL_TRACE_EVENT_QUEUE_BLOCK_RECEIVE,   /* The running task blocks on an empty queue */
+  KERNEL_TRACE_EVENT__N,
+} kernel_trace_event_t;
+
+typedef struct
+{
+  uint32_t delta;                   /* DWT cycles since the previous record */
+  uint8_t event;
+  uint8_t flags;
+  uint16_t object;
+} kernel_trace_record_t;
+
+/*
+ * Self describing image read by tools/trace_to_perfetto.py, little endian. Dump it with
+ *   (gdb) dump binary value trace.bin kernel_trace
+ * the oldest record is record[written - capacity] once the ring wrapped, its time is base
+ * plus its delta.
+ */
+typedef struct
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t record_size;
+  uint32_t capacity;
+  uint32_t written;
+  uint32_t clock_hz;
+  uint16_t names;
+  uint16_t name_len;
+  uint64_t base;
+  char name[KERNEL_TRACE_CONFIG_NAMES][KERNEL_TRACE_NAME_LEN];
+  kernel_trace_record_t record[KERNEL_TRACE_CONFIG_RECORDS];
+} kernel_trace_t;
+
+/********************** external data declaration ****************************/
+
+extern kernel_trace_t kernel_trace;
+
+/********************** external functions declaration ***********************/
+
+/*
+ * Hooks for the FreeRTOS trace macros, see FreeRTOSConfig.h. Most run with interrupts
+ * masked, not all of them, each write into the ring masks them itself. The create hook
+ * numbers every task from 1 (uxTaskGetTaskNumber()), also with the recorder disabled.
+ */
+void kernel_trace_task_switched_in(void* htask);
+void kernel_trace_task_switched_out(void* htask);
+void kernel_trace_task_create(void* htask);
+void kernel_trace_task_delete(void* htask);
+void kernel_trace_queue_create(void* hqueue);
+void kernel_trace_queue_send(void* hqueue, int from_isr);
+void kernel_trace_queue_receive(void* hqueue, int from_isr);
+void kernel_trace_queue_block(void* hqueue, int receive);
+
+/* Freezes the ring, so the records around a glitch survive until they are dumped */
+void kernel_trace_stop(void);
+
+/* Empties the ring and records again */
+void kernel_trace_start(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KERNEL_TRACE_H_ */
+/********************** end of file ******************************************/
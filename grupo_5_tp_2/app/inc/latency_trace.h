@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : latency_trace.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef LATENCY_TRACE_H_
+#define LATENCY_TRACE_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+
+#define LATENCY_TRACE_CONFIG_ENABLE             (1)
+#define LATENCY_TRACE_CONFIG_SLOTS              (8)     /* Events traced at the same time */
+#define LATENCY_TRACE_CONFIG_BUCKETS            (24)    /* log2(us) buckets, up to ~16 s */
+#define LATENCY_TRACE_CONFIG_REPORT_MS          (10000) /* Period of the report, 0 disables it. Run by the stack monitor task */
+
+/* Trace id carried by untraced events */
+#define LATENCY_TRACE_ID_NONE                   (0)
+
+/********************** typedef **********************************************/
+
+/* Stages of a button event, in the order it goes through them */
+typedef enum
+{
+  LATENCY_STAGE_BUTTON_READ,
+  LATENCY_STAGE_BUTTON_CLASSIFY,
+  LATENCY_STAGE_UI_DISPATCH,
+  LATENCY_STAGE_LED_QUEUE,
+  LATENCY_STAGE_LED_ON,
+  LATENCY_STAGE__N,
+} latency_stage_t;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+#if (1 == LATENCY_TRACE_CONFIG_ENABLE)
+
+/* Starts tracing an event read at read_cycles (DWT CYCCNT), returns its correlation id */
+uint32_t latency_trace_begin(uint32_t read_cycles);
+
+/* Timestamps a stage of the event, the last stage closes it and feeds the histograms.
+ * Stages may be skipped, a stage's histogram only takes events stamped at it and before it */
+void latency_trace_stamp(uint32_t trace_id, latency_stage_t stage);
+
+/* Logs count, min, mean, max and percentiles of every stage and of the whole path. Called
+ * by the stack monitor task every LATENCY_TRACE_CONFIG_REPORT_MS */
+void latency_trace_report(void);
+
+#else
+
+#define latency_trace_begin(read_cycles)        ((void)(read_cycles), LATENCY_TRACE_ID_NONE)
+#define latency_trace_stamp(trace_id, stage)    ((void)(trace_id))
+#define latency_trace_report()
+
+#endif
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LATENCY_TRACE_H_ */
+/********************** end of file ******************************************/
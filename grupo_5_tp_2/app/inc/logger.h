@@ -53,35 +53,201 @@ extern "C" {
 
 #define LOGGER_CONFIG_ENABLE                    (1)
 #define LOGGER_CONFIG_MAXLEN                    (64)
-#define LOGGER_CONFIG_USE_SEMIHOSTING           (1)
+#define LOGGER_CONFIG_SLOTS                     (16)    /* Shared ring, power of two */
+#define LOGGER_CONFIG_CHANNELS                  (8)     /* Tasks with their own buffer, up to 32 */
+#define LOGGER_CONFIG_CHANNEL_SLOTS             (4)     /* Per task buffer, power of two */
+#define LOGGER_CONFIG_TLS_INDEX                 (0)     /* Thread local storage pointer holding the buffer */
+
+#define LOGGER_BACKEND_NONE                     (0)
+#define LOGGER_BACKEND_SEMIHOSTING              (1)     /* Halts the core on every write, debugger only */
+#define LOGGER_BACKEND_UART_DMA                 (2)     /* USART3 (ST-LINK virtual COM port) fed by DMA1 stream 3 */
+#define LOGGER_CONFIG_BACKEND                   (LOGGER_BACKEND_UART_DMA)
+
+#define LOGGER_CONFIG_UART_BAUDRATE             (921600)    /* Up to 5.25 Mbaud, oversampling by 8 above 2.625 Mbaud */
+#define LOGGER_CONFIG_UART_BUFFER               (512)       /* Bytes per half of the double buffer */
+
+/* 1: only the format string id, a DWT timestamp and the raw argument words are sent, the
+ *    strings stay in the ELF and tools/log_decoder.py turns the stream back into text.
+ *    Arguments must be 32 bit or narrower, %s is decoded only for strings in flash. */
+#define LOGGER_CONFIG_TOKENIZED                 (0)
+#define LOGGER_TOKEN_MAX_ARGS                   (8)
+#define LOGGER_TOKEN_SYNC                       (0xA5)
+
+/* Every LOGGER_<level> call site owns a token bucket and remembers its last message */
+#define LOGGER_CONFIG_SITE_BURST                (4)     /* Messages a site may log back to back */
+#define LOGGER_CONFIG_SITE_PERIOD_MS            (250)   /* One more token every period */
+#define LOGGER_CONFIG_SITE_REPEAT_MS            (5000)  /* Pending counts are reported at least this often */
 
 #if 1 == LOGGER_CONFIG_ENABLE
-#define LOGGER_LOG(...)\
-    taskENTER_CRITICAL();\
+#if 1 == LOGGER_CONFIG_TOKENIZED
+#define LOGGER_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...)    n
+#define LOGGER_NARGS(...)   LOGGER_NARGS_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOGGER_SITE_LOG_(psite, fmt, ...)\
+    do\
     {\
-        logger_msg_len = snprintf(logger_msg, (LOGGER_CONFIG_MAXLEN - 1), __VA_ARGS__);\
-        logger_log_print_(logger_msg);\
-    }\
-    taskEXIT_CRITICAL()
+        __attribute__((section(".logstr"), used)) static const char logger_fmt_[] = fmt;\
+        logger_log_token_site((psite), logger_fmt_, LOGGER_NARGS(__VA_ARGS__), ##__VA_ARGS__);\
+    } while (0)
+#define LOGGER_LOG(fmt, ...)    LOGGER_SITE_LOG_(NULL, fmt, ##__VA_ARGS__)
+#else
+#define LOGGER_SITE_LOG_(psite, ...)    logger_log_site((psite), __VA_ARGS__)
+#define LOGGER_LOG(...)                 logger_log(__VA_ARGS__)
+#endif
 #else
+#define LOGGER_SITE_LOG_(psite, ...)
 #define LOGGER_LOG(...)
 #endif
 
-#define LOGGER_INFO(...)\
-    LOGGER_LOG("[info] ");\
-    LOGGER_LOG(__VA_ARGS__);\
-    LOGGER_LOG("\n");
+#define LOGGER_LEVEL_TRACE                      (0)
+#define LOGGER_LEVEL_DEBUG                      (1)
+#define LOGGER_LEVEL_INFO                       (2)
+#define LOGGER_LEVEL_WARN                       (3)
+#define LOGGER_LEVEL_ERROR                      (4)
+#define LOGGER_LEVEL_NONE                       (5)
+
+/*
+ * Modules and their compile time threshold, messages below it generate no code. A source
+ * file picks its module defining LOGGER_MODULE before its first include, APP otherwise.
+ */
+#define LOGGER_MODULE_TABLE(X)\
+/*  module,     threshold */\
+  X(APP,        LOGGER_LEVEL_INFO)\
+  X(BUTTON,     LOGGER_LEVEL_INFO)\
+  X(UI,         LOGGER_LEVEL_INFO)\
+  X(LED,        LOGGER_LEVEL_INFO)\
+  X(LATENCY,    LOGGER_LEVEL_INFO)\
+  X(PROF,       LOGGER_LEVEL_INFO)\
+  X(STACK,      LOGGER_LEVEL_INFO)\
+  X(LOGGER,     LOGGER_LEVEL_INFO)
+
+#ifndef LOGGER_MODULE
+#define LOGGER_MODULE                           APP
+#endif
+
+#define LOGGER_CAT_(a, b)                       a##b
+#define LOGGER_MODULE_ID_(module)               LOGGER_CAT_(LOGGER_MODULE_ID_, module)
+#define LOGGER_MODULE_THRESHOLD_(module)        LOGGER_CAT_(LOGGER_MODULE_THRESHOLD_, module)
+
+/* The first test is a constant the compiler folds away, the second one a load and a compare
+ * against the runtime level, both before any formatting. The static site is the per call
+ * site rate limit and repeat state, zero initialized */
+#define LOGGER_LEVEL_LOG_(level, tag, fmt, ...)\
+    do\
+    {\
+        if (((level) >= LOGGER_MODULE_THRESHOLD_(LOGGER_MODULE)) &&\
+            ((level) >= logger_level[LOGGER_MODULE_ID_(LOGGER_MODULE)]))\
+        {\
+            static logger_site_t logger_site_;\
+            LOGGER_SITE_LOG_(&logger_site_, "[" tag "] " fmt "\n", ##__VA_ARGS__);\
+        }\
+    } while (0)
+
+#define LOGGER_TRACE(fmt, ...)      LOGGER_LEVEL_LOG_(LOGGER_LEVEL_TRACE, "trace", fmt, ##__VA_ARGS__)
+#define LOGGER_DEBUG(fmt, ...)      LOGGER_LEVEL_LOG_(LOGGER_LEVEL_DEBUG, "debug", fmt, ##__VA_ARGS__)
+#define LOGGER_INFO(fmt, ...)       LOGGER_LEVEL_LOG_(LOGGER_LEVEL_INFO, "info", fmt, ##__VA_ARGS__)
+#define LOGGER_WARN(fmt, ...)       LOGGER_LEVEL_LOG_(LOGGER_LEVEL_WARN, "warn", fmt, ##__VA_ARGS__)
+#define LOGGER_ERROR(fmt, ...)      LOGGER_LEVEL_LOG_(LOGGER_LEVEL_ERROR, "error", fmt, ##__VA_ARGS__)
+
+/* Info level for report loops, one call site writing a line per probe or task on purpose:
+ * no token bucket and no repeat check */
+#define LOGGER_REPORT(fmt, ...)\
+    do\
+    {\
+        if ((LOGGER_LEVEL_INFO >= LOGGER_MODULE_THRESHOLD_(LOGGER_MODULE)) &&\
+            (LOGGER_LEVEL_INFO >= logger_level[LOGGER_MODULE_ID_(LOGGER_MODULE)]))\
+        {\
+            LOGGER_SITE_LOG_(NULL, "[info] " fmt "\n", ##__VA_ARGS__);\
+        }\
+    } while (0)
 
 #define GET_NAME(var)  #var
 
 /********************** typedef **********************************************/
 
-extern char* const logger_msg;
-extern int logger_msg_len; // only for debug information
+#define LOGGER_MODULE_ENUM_(module, threshold)          LOGGER_MODULE_ID_##module,
+typedef enum
+{
+  LOGGER_MODULE_TABLE(LOGGER_MODULE_ENUM_)
+  LOGGER_MODULE__N,
+} logger_module_t;
+#undef LOGGER_MODULE_ENUM_
+
+#define LOGGER_MODULE_THRESHOLD_ENUM_(module, threshold) LOGGER_MODULE_THRESHOLD_##module = (threshold),
+enum
+{
+  LOGGER_MODULE_TABLE(LOGGER_MODULE_THRESHOLD_ENUM_)
+};
+#undef LOGGER_MODULE_THRESHOLD_ENUM_
+
+/* Call site state, counters aside updated without locking: concurrent logs from one site
+ * may let a token or a repeat slip */
+typedef struct logger_site
+{
+  struct logger_site* pnext;    /* Sites swept by the drain task, linked on first use */
+  const char* fmt;              /* Names the site in its reports */
+  uint32_t refill_ms;           /* Tick of the last token added */
+  uint32_t repeat_ms;           /* Tick of the first repeat not reported yet */
+  uint32_t limited_ms;          /* Tick of the first drop not reported yet */
+  uint32_t hash;                /* FNV-1a of the last message written */
+  uint16_t repeats;             /* Copies of the last message swallowed */
+  uint16_t limited;             /* Messages dropped by the bucket */
+  uint8_t tokens;
+  bool primed;                  /* Claimed by the first use, which fills the bucket and links the site */
+  bool hashed;
+} logger_site_t;
+
+/********************** external data declaration ****************************/
+
+/* Runtime level of each module, starts at its compile time threshold */
+extern uint8_t logger_level[LOGGER_MODULE__N];
 
 /********************** external functions declaration ***********************/
 
-void logger_log_print_(char* const msg);
+/* Creates the drain task, messages logged before are kept and written once it runs */
+void logger_init(void);
+
+/*
+ * Formats a message with logger_vformat(), timestamped with DWT, and wakes the drain task.
+ * A task writes into its own single producer buffer, claimed on its first log, ISRs and
+ * tasks left without one use the shared ring. Never blocks nor masks interrupts, a full
+ * buffer drops and counts, a message longer than LOGGER_CONFIG_MAXLEN is cut and counted.
+ */
+void logger_log(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/*
+ * Tokenized counterpart of logger_log(), called by LOGGER_LOG. Queues the record
+ * sync (u8), nargs (u8), id (u32), DWT cycles (u32), nargs words (u32), little endian.
+ */
+void logger_log_token(const char* fmt, uint32_t nargs, ...);
+
+/*
+ * logger_log() behind the site's repeat check and token bucket. A message equal to the last
+ * one of the site is swallowed and counted, "repeated N times: <fmt>" is written before
+ * the next different one, or by the drain task once the site goes quiet. Only new
+ * messages take a token, a site drops its bursts and the ring stays free for the rest.
+ */
+void logger_log_site(logger_site_t* psite, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/* Tokenized counterpart of logger_log_site(), repeats compare the format and the arguments */
+void logger_log_token_site(logger_site_t* psite, const char* fmt, uint32_t nargs, ...);
+
+/* Crash path: copies the messages not drained yet into the crash log, from crash_log_seal() */
+void logger_crash_flush(void);
+
+/* traceTASK_DELETE hook, the buffer of the deleted task is freed once drained */
+void logger_task_deleted(void* htask);
+
+/* Changes the runtime level of a module, levels below its compile time threshold stay out */
+void logger_level_set(logger_module_t module, uint8_t level);
+
+/* Messages dropped so far because the ring was full */
+uint32_t logger_dropped(void);
+
+/* Messages cut to LOGGER_CONFIG_MAXLEN - 1 characters so far */
+uint32_t logger_truncated(void);
+
+/* Backend, writes len bytes of buf from the drain task, may sleep but never spins */
+void logger_log_print_(const char* buf, size_t len);
 
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
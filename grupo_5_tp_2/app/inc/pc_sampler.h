@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : pc_sampler.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef PC_SAMPLER_H_
+#define PC_SAMPLER_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+
+/*
+ * The rate and priority are TIM2's, set in the .ioc: 84 MHz / 16803 = 4999 Hz, off the
+ * 1 kHz tick so tick work is not over or under sampled, and NVIC priority 4, above
+ * configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY so samples land in critical sections too.
+ */
+#define PC_SAMPLER_CONFIG_ENABLE        (1)
+#define PC_SAMPLER_CONFIG_ENTRIES       (512)   /* Distinct (pc, task) pairs, power of two */
+#define PC_SAMPLER_CONFIG_NAMES         (16)    /* Task names kept, by task number */
+
+#define PC_SAMPLER_MAGIC                (0x4D534350UL)  /* "PCSM" */
+#define PC_SAMPLER_VERSION              (1)
+#define PC_SAMPLER_NAME_LEN             (16)
+
+/********************** typedef **********************************************/
+
+typedef struct
+{
+  uint32_t pc;                      /* 0: free */
+  uint16_t task;                    /* Task number, from 1 */
+  uint16_t reserved;
+  uint32_t count;
+} pc_sampler_entry_t;
+
+/*
+ * Self describing image read by tools/pc_profile.py, little endian. Dump it with
+ *   (gdb) dump binary value pcs.bin pc_sampler
+ */
+typedef struct
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t entry_size;
+  uint32_t capacity;
+  uint32_t rate_hz;                 /* From TIM2's registers, at init */
+  uint32_t samples;                 /* All of them, including the ones below */
+  uint32_t handler;                 /* Another ISR was interrupted, its frame is out of reach */
+  uint32_t startup;                 /* Thread mode on MSP, before the scheduler started */
+  uint32_t dropped;                 /* Table full */
+  uint16_t names;
+  uint16_t name_len;
+  char name[PC_SAMPLER_CONFIG_NAMES][PC_SAMPLER_NAME_LEN];   /* By task number modulo names, last one seen */
+  pc_sampler_entry_t entry[PC_SAMPLER_CONFIG_ENTRIES];
+} pc_sampler_t;
+
+/********************** external data declaration ****************************/
+
+extern pc_sampler_t pc_sampler;
+
+/********************** external functions declaration ***********************/
+
+#if (1 == PC_SAMPLER_CONFIG_ENABLE)
+
+/* Starts TIM2's update interrupt, as configured by MX_TIM2_Init() */
+void pc_sampler_init(void);
+
+/* From TIM2_IRQHandler, first thing, with the EXC_RETURN value still in LR */
+void pc_sampler_sample(uint32_t exc_return);
+
+/* Empties the histogram */
+void pc_sampler_reset(void);
+
+#else
+
+#define pc_sampler_init()
+#define pc_sampler_sample(exc_return)
+#define pc_sampler_reset()
+
+#endif
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PC_SAMPLER_H_ */
+/********************** end of file ******************************************/
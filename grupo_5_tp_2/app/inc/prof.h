@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : prof.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef PROF_H_
+#define PROF_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "dwt.h"
+
+/********************** macros ***********************************************/
+
+#define PROF_CONFIG_ENABLE                      (1)
+#define PROF_CONFIG_BUCKETS                     (32)    /* log2(cycles) buckets */
+#define PROF_CONFIG_REPORT_MS                   (10000) /* Period of the reports, 0 disables them. Run by the stack monitor task */
+#define PROF_CONFIG_CPU_TASKS                   (16)    /* Tasks the CPU report can cover */
+
+/*
+ * Probe points, timed with DWT cycles net of the probe's own cost. A new probe is a row
+ * here and a PROF_SCOPE(), or a PROF_BEGIN() / PROF_END() pair, around the code.
+ */
+#define PROF_PROBE_TABLE(X)\
+/*  probe,          name */\
+  X(LED_POOL_GET,   "led pool get")\
+  X(LED_GPIO_WRITE, "led gpio write")\
+  X(BUS_QUEUE_SEND, "bus queue send")
+
+#if (1 == PROF_CONFIG_ENABLE)
+
+/* Both in the same block, the start is a local so nested and concurrent probes are fine */
+#define PROF_BEGIN(probe)       const uint32_t prof_start_##probe##_ = cycle_counter_get()
+#define PROF_END(probe)         prof_record(PROF_ID_##probe, cycle_counter_get() - prof_start_##probe##_)
+
+/* Times the rest of the enclosing block, however it is left */
+#define PROF_SCOPE(probe)\
+    prof_scope_t prof_scope_##probe##_ __attribute__((cleanup(prof_scope_end_))) =\
+    {\
+      .id = PROF_ID_##probe,\
+      .start = cycle_counter_get(),\
+    }
+
+#else
+
+#define PROF_BEGIN(probe)
+#define PROF_END(probe)
+#define PROF_SCOPE(probe)
+
+#endif
+
+/********************** typedef **********************************************/
+
+#define PROF_ID_ENUM_(probe, name)      PROF_ID_##probe,
+typedef enum
+{
+  PROF_PROBE_TABLE(PROF_ID_ENUM_)
+  PROF_ID__N,
+} prof_id_t;
+#undef PROF_ID_ENUM_
+
+typedef struct
+{
+  prof_id_t id;
+  uint32_t start;
+} prof_scope_t;
+
+typedef struct
+{
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint32_t bucket[PROF_CONFIG_BUCKETS];     /* Bucket b holds [2^(b-1), 2^b) cycles */
+} prof_stats_t;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+#if (1 == PROF_CONFIG_ENABLE)
+
+/* Measures the probe overhead, with the cycle counter running */
+void prof_init(void);
+
+/* Adds a sample, in cycles, to a probe. Tasks and ISRs */
+void prof_record(prof_id_t id, uint32_t cycles);
+
+/* Copy of a probe's statistics */
+void prof_stats_get(prof_id_t id, prof_stats_t* pstats);
+
+/* Logs count, min, mean, max and percentiles of every probe hit so far */
+void prof_report(void);
+
+/* Logs the share of CPU time each task got since the previous call, from the run time
+ * stats (DWT cycles). Runs with the scheduler suspended for a moment */
+void prof_cpu_report(void);
+
+void prof_reset(void);
+
+static inline void prof_scope_end_(prof_scope_t* pscope)
+{
+  prof_record(pscope->id, cycle_counter_get() - pscope->start);
+}
+
+#else
+
+#define prof_init()
+#define prof_record(id, cycles)
+#define prof_report()
+#define prof_cpu_report()
+#define prof_reset()
+
+#endif
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROF_H_ */
+/********************** end of file ******************************************/
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : prof_critical.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef PROF_CRITICAL_H_
+#define PROF_CRITICAL_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+
+/*
+ * Times every taskENTER_CRITICAL() / portENTER_CRITICAL() section, the kernel's included.
+ * The linker routes vPortEnterCritical() and vPortExitCritical() through this module with
+ * -Wl,--wrap=vPortEnterCritical,--wrap=vPortExitCritical (project linker flags), with the
+ * module disabled the wrappers only forward.
+ */
+#define PROF_CRITICAL_CONFIG_ENABLE             (1)
+#define PROF_CRITICAL_CONFIG_TOP                (8)     /* Call sites kept, the longest ones */
+
+/********************** typedef **********************************************/
+
+typedef struct
+{
+  uint32_t site;                    /* Return address of the enter call, addr2line -f -e <elf> */
+  uint32_t count;
+  uint32_t max;                     /* Cycles with interrupts masked */
+} prof_critical_site_t;
+
+typedef struct
+{
+  uint32_t count;                   /* Outermost sections, nested ones add to their owner */
+  uint64_t sum;
+  uint32_t max;
+  uint32_t depth;                   /* Current nesting */
+  uint32_t depth_max;
+  prof_critical_site_t top[PROF_CRITICAL_CONFIG_TOP];
+} prof_critical_stats_t;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+#if (1 == PROF_CRITICAL_CONFIG_ENABLE)
+
+/* Copy of the statistics */
+void prof_critical_stats_get(prof_critical_stats_t* pstats);
+
+/* Logs the totals and the top call sites, longest first */
+void prof_critical_report(void);
+
+void prof_critical_reset(void);
+
+#else
+
+#define prof_critical_report()
+#define prof_critical_reset()
+
+#endif
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROF_CRITICAL_H_ */
+/********************** end of file ******************************************/
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : stack_mon.h
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+#ifndef STACK_MON_H_
+#define STACK_MON_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+
+#define STACK_MON_CONFIG_ENABLE                 (1)
+#define STACK_MON_CONFIG_PERIOD_MS              (5000)  /* Sampling period, APP_TASK_ID_STACK_MON row */
+#define STACK_MON_CONFIG_TASKS                  (16)    /* Distinct task names followed */
+#define STACK_MON_CONFIG_MARGIN_PCT             (25)    /* Headroom on top of the deepest use seen */
+#define STACK_MON_CONFIG_MARGIN_WORDS           (32)    /* At least this much, an FPU exception frame is 26 */
+#define STACK_MON_CONFIG_ROUND_WORDS            (8)     /* Recommendations are multiples of this */
+
+/********************** typedef **********************************************/
+
+typedef struct
+{
+  const char* name;
+  uint32_t stack_words;             /* 0 when the monitor does not know the size */
+  uint32_t free_words;              /* Least free ever seen, under every task of this name */
+  uint32_t recommended_words;       /* 0 when stack_words is unknown */
+} stack_mon_entry_t;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+#if (1 == STACK_MON_CONFIG_ENABLE)
+
+/* Creates the monitor task, which also runs the PROF_CONFIG_REPORT_MS and
+ * LATENCY_TRACE_CONFIG_REPORT_MS reports */
+void stack_mon_init(void);
+
+/* Copies the entry-th followed task, false past the last one */
+bool stack_mon_get(uint32_t entry, stack_mon_entry_t* pentry);
+
+#else
+
+#define stack_mon_init()
+
+#endif
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_MON_H_ */
+/********************** end of file ******************************************/
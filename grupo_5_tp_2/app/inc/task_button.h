@@ -44,6 +44,17 @@ extern "C" {
 
 /********************** macros ***********************************************/
 
+#define BUTTON_MODE_POLL            (0)     /* The task polls the pin every 50 ms */
+#define BUTTON_MODE_EXTI            (1)     /* Pin edges raise EXTI, a one-shot timer debounces them */
+#define BUTTON_MODE_CAPTURE         (2)     /* TIM5 input capture on PA0 measures the hold time in hardware,
+                                               PC13 must be jumpered to PA0 */
+#define BUTTON_MODE_SCAN            (3)     /* Every BUTTON_A/B/C input is sampled from the port IDRs and
+                                               debounced in parallel with vertical counters */
+
+#define BUTTON_CONFIG_MODE          (BUTTON_MODE_EXTI)
+#define BUTTON_DEBOUNCE_MS          (20)
+#define BUTTON_SCAN_PERIOD_MS       (BUTTON_DEBOUNCE_MS / 4)    /* Vertical counters need four equal samples */
+
 /********************** typedef **********************************************/
 typedef enum
 {
@@ -53,12 +64,23 @@ typedef enum
   BUTTON_TYPE_LONG,
   BUTTON_TYPE__N,
 } button_type_t;
+
+typedef enum
+{
+  BUTTON_ID_A,
+  BUTTON_ID_B,
+  BUTTON_ID_C,
+  BUTTON_ID__N,
+} button_id_t;
 /********************** external data declaration ****************************/
 
 /********************** external functions declaration ***********************/
 
 void task_button(void* argument);
 
+/* TIM5 interrupt body, BUTTON_MODE_CAPTURE only */
+void button_capture_irq_handler(void);
+
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
 }
@@ -62,7 +62,8 @@ typedef struct msg_s message_t;
 struct msg_s {
     size_t size;
 	button_type_t button;
-
+	button_id_t id;			/* Button that raised the event */
+	uint32_t trace_id;		/* Latency trace correlation id */
 
 };
 
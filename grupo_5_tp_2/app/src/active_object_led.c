@@ -34,6 +34,8 @@
 
 /* ============================================================================================ */
 
+#define LOGGER_MODULE LED   // Before logger.h
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -47,56 +49,320 @@
 #include "active_object_led.h"
 #include "task_led.h"
 #include "task_button.h"
-#define MAX_TASKS (3)
+#include "event_bus.h"
+#include "latency_trace.h"
+#include "prof.h"
+#define MAX_TASKS (MAX_LED_TASKS)
 
 memory_pool_t led_task_pool;
 QueueHandle_t led_event_queue;
+
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+static uint8_t led_event_queue_storage_[LED_AO_QUEUE_LENGTH * sizeof(LedTask_t)];
+static StaticQueue_t led_event_queue_buffer_;
+#endif
+
+#if (1 == LED_AO_CONFIG_USE_PULSE_TIMERS)
+/* One in-flight LED pulse. The first member is overwritten by the pool while the slot is free */
+typedef struct
+{
+	memory_pool_block_t pool_node;
+	TimerHandle_t htimer;
+	led_color_t color;
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+	StaticTimer_t timer_buffer;
+#endif
+} led_pulse_t;
+
+static led_pulse_t led_pulse_memory_[LED_PULSE_POOL_SIZE];
+static memory_pool_t led_pulse_pool_;
+
+/* Pulses currently holding each LED on, the LED goes off when its count drops to zero */
+static uint8_t led_on_count_[LED_COLOR__N];
+#else
+#if (0 == configSUPPORT_STATIC_ALLOCATION)
+#error "The LED worker cache needs configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+/* Recycled LED worker: TCB, stack and payload. The first member is overwritten by the pool while the slot is free */
+typedef struct
+{
+	memory_pool_block_t pool_node;
+	TaskHandle_t htask;
+	LedTask_t cmd;
+	StaticTask_t tcb;
+	StackType_t stack[APP_TASK_STACK_LED_WORKER];
+} led_worker_t;
+
+static led_worker_t led_worker_memory_[MAX_TASKS];
+
+/* Finished workers waiting for the reaper */
+static QueueHandle_t led_reaper_queue_;
+static uint8_t led_reaper_queue_storage_[MAX_TASKS * sizeof(led_worker_t*)];
+static StaticQueue_t led_reaper_queue_buffer_;
+static StackType_t led_reaper_stack_[APP_TASK_STACK_LED_REAPER];
+static StaticTask_t led_reaper_tcb_;
+
+/* Events waiting for a worker, served in arrival order */
+typedef struct
+{
+	LedTask_t cmd;
+	TickType_t enqueued;
+} led_pending_t;
+
+static QueueHandle_t led_pending_queue_;
+static uint8_t led_pending_queue_storage_[LED_PENDING_QUEUE_LENGTH * sizeof(led_pending_t)];
+static StaticQueue_t led_pending_queue_buffer_;
+
+/* Serializes dispatching between the LED AO and the reaper */
+static SemaphoreHandle_t led_dispatch_mutex_;
+static StaticSemaphore_t led_dispatch_mutex_buffer_;
+
 static int task_cnt_;
 
+static led_admission_stats_t led_admission_stats_;
+#endif
+
+static void (* const led_set_state_[LED_COLOR__N])(led_cmd_t cmd) =
+{
+	[LED_COLOR_RED]   = led_red_set_state,
+	[LED_COLOR_GREEN] = led_green_set_state,
+	[LED_COLOR_BLUE]  = led_blue_set_state,
+};
+
 /* ============================================================================================ */
 
-static void delete_task_(void)
+static bool led_color_is_valid_(led_color_t color)
+{
+	return (color < LED_COLOR__N) && (NULL != led_set_state_[color]);
+}
+
+#if (1 == LED_AO_CONFIG_USE_PULSE_TIMERS)
+
+static void led_pulse_off_(led_color_t color)
+{
+	taskENTER_CRITICAL();
+	if (0 < led_on_count_[color])
+	{
+		led_on_count_[color]--;
+		if (0 == led_on_count_[color])
+		{
+			led_set_state_[color](LED_CMD_OFF);
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/* Runs in the timer service task once the on-duration of a pulse has elapsed */
+static void led_pulse_expired_(TimerHandle_t htimer)
+{
+	led_pulse_t* ppulse = (led_pulse_t*)pvTimerGetTimerID(htimer);
+
+	led_pulse_off_(ppulse->color);
+	memory_pool_block_put(&led_pulse_pool_, ppulse);
+}
+
+static void led_pulse_start_(const LedTask_t* pcmd)
+{
+	led_color_t color = pcmd->color;
+	PROF_BEGIN(LED_POOL_GET);
+	led_pulse_t* ppulse = (led_pulse_t*)memory_pool_block_get(&led_pulse_pool_);
+	PROF_END(LED_POOL_GET);
+	if (NULL == ppulse)
+	{
+		LOGGER_WARN("No free LED pulse");
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	led_on_count_[color]++;
+	PROF_BEGIN(LED_GPIO_WRITE);
+	led_set_state_[color](LED_CMD_ON);
+	PROF_END(LED_GPIO_WRITE);
+	taskEXIT_CRITICAL();
+	latency_trace_stamp(pcmd->trace_id, LATENCY_STAGE_LED_ON);
+
+	ppulse->color = color;
+	if (pdPASS != xTimerStart(ppulse->htimer, 0))
+	{
+		LOGGER_ERROR("Failed to start LED pulse timer");
+		led_pulse_off_(color);
+		memory_pool_block_put(&led_pulse_pool_, ppulse);
+	}
+}
+
+static void led_pulse_pool_init_(void)
+{
+	memory_pool_init(&led_pulse_pool_, led_pulse_memory_, LED_PULSE_POOL_SIZE, sizeof(led_pulse_t));
+
+	for (size_t i = 0; i < LED_PULSE_POOL_SIZE; ++i)
+	{
+		led_pulse_t* ppulse = &led_pulse_memory_[i];
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+		ppulse->htimer = xTimerCreateStatic("LED pulse", pdMS_TO_TICKS(LED_PULSE_DURATION_MS), pdFALSE,
+		                                    ppulse, led_pulse_expired_, &ppulse->timer_buffer);
+#else
+		ppulse->htimer = xTimerCreate("LED pulse", pdMS_TO_TICKS(LED_PULSE_DURATION_MS), pdFALSE,
+		                              ppulse, led_pulse_expired_);
+#endif
+		configASSERT(NULL != ppulse->htimer);
+	}
+}
+
+#else
+
+static void led_worker_run_(void *argument)
+{
+	led_worker_t* pworker = (led_worker_t*)argument;
+	LedTask_t* pcmd = &pworker->cmd;
+
+	led_set_state_[pcmd->color](LED_CMD_ON);
+	latency_trace_stamp(pcmd->trace_id, LATENCY_STAGE_LED_ON);
+	vTaskDelay(pdMS_TO_TICKS(LED_PULSE_DURATION_MS));
+	led_set_state_[pcmd->color](LED_CMD_OFF);
+
+	/* The reaper deletes this task and recycles its slot, there is nothing left for the idle task */
+	xQueueSend(led_reaper_queue_, &pworker, portMAX_DELAY);
+	vTaskSuspend(NULL);
+}
+
+static void led_worker_dispatch_(void);
+
+/* Runs above the workers, so a worker is deleted as soon as it reports itself finished */
+static void led_reaper_run_(void *argument)
+{
+	led_worker_t* pworker;
+	while (true)
+	{
+		if (pdPASS == xQueueReceive(led_reaper_queue_, &pworker, portMAX_DELAY))
+		{
+			vTaskDelete(pworker->htask);
+			memory_pool_block_put(&led_task_pool, pworker);
+
+			LOGGER_DEBUG("Elimino tarea");
+			taskENTER_CRITICAL();
+			int task_cnt = --task_cnt_;
+			taskEXIT_CRITICAL();
+			LOGGER_DEBUG("Cantidad de procesos: %d", task_cnt);
+
+			led_worker_dispatch_();
+		}
+	}
+}
+
+static void led_worker_spawn_(led_worker_t* pworker, const LedTask_t *payload)
+{
+	pworker->cmd = *payload;
+
+	taskENTER_CRITICAL();
+	task_cnt_++;
+	taskEXIT_CRITICAL();
+
+	const app_task_config_t* pconfig = &app_task_config[APP_TASK_ID_LED_WORKER];
+	pworker->htask = xTaskCreateStatic(led_worker_run_, payload->name, APP_TASK_STACK_LED_WORKER, pworker,
+	                                   tskIDLE_PRIORITY + pconfig->priority, pworker->stack, &pworker->tcb);
+	LOGGER_DEBUG("New task %s", payload->name);
+}
+
+/* Hands pending events to free workers, oldest first, dropping those that waited too long */
+static void led_worker_dispatch_(void)
+{
+	led_pending_t pending;
+
+	xSemaphoreTake(led_dispatch_mutex_, portMAX_DELAY);
+	while (pdPASS == xQueuePeek(led_pending_queue_, &pending, 0))
+	{
+		if (pdMS_TO_TICKS(LED_PENDING_MAX_WAIT_MS) < (xTaskGetTickCount() - pending.enqueued))
+		{
+			xQueueReceive(led_pending_queue_, &pending, 0);
+			taskENTER_CRITICAL();
+			led_admission_stats_.expired++;
+			taskEXIT_CRITICAL();
+			LOGGER_WARN("Expired %s", pending.cmd.name);
+			continue;
+		}
+
+		led_worker_t* pworker = (led_worker_t*)memory_pool_block_get(&led_task_pool);
+		if (NULL == pworker)
+		{
+			break;
+		}
+
+		xQueueReceive(led_pending_queue_, &pending, 0);
+		taskENTER_CRITICAL();
+		led_admission_stats_.dispatched++;
+		taskEXIT_CRITICAL();
+		led_worker_spawn_(pworker, &pending.cmd);
+	}
+	xSemaphoreGive(led_dispatch_mutex_);
+}
+
+/* Every event goes through the pending queue, so a new one never overtakes a waiting one */
+static void create_led_task_(const LedTask_t *payload)
+{
+	led_pending_t pending = { .cmd = *payload, .enqueued = xTaskGetTickCount() };
+
+	if (pdPASS != xQueueSend(led_pending_queue_, &pending, 0))
+	{
+		taskENTER_CRITICAL();
+		led_admission_stats_.rejected++;
+		taskEXIT_CRITICAL();
+		LOGGER_WARN("Pending queue full, dropped %s", payload->name);
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	led_admission_stats_.accepted++;
+	int task_cnt = task_cnt_;
+	taskEXIT_CRITICAL();
+	if (MAX_TASKS <= task_cnt)
+	{
+		LOGGER_INFO("Awaiting for free task...");
+	}
+	led_worker_dispatch_();
+}
+
+static void led_worker_cache_init_(void)
 {
-	LOGGER_INFO("Elimino tarea");
-	task_cnt_--;
-	LOGGER_INFO("Cantidad de procesos: %d", task_cnt_);
-	vTaskDelete(NULL);
+	memory_pool_init(&led_task_pool, led_worker_memory_, MAX_TASKS, sizeof(led_worker_t));
+
+	led_reaper_queue_ = xQueueCreateStatic(MAX_TASKS, sizeof(led_worker_t*),
+	                                       led_reaper_queue_storage_, &led_reaper_queue_buffer_);
+	configASSERT(NULL != led_reaper_queue_);
+
+	led_pending_queue_ = xQueueCreateStatic(LED_PENDING_QUEUE_LENGTH, sizeof(led_pending_t),
+	                                        led_pending_queue_storage_, &led_pending_queue_buffer_);
+	configASSERT(NULL != led_pending_queue_);
+
+	led_dispatch_mutex_ = xSemaphoreCreateMutexStatic(&led_dispatch_mutex_buffer_);
+	configASSERT(NULL != led_dispatch_mutex_);
+
+	const app_task_config_t* pconfig = &app_task_config[APP_TASK_ID_LED_REAPER];
+	TaskHandle_t hreaper = xTaskCreateStatic(led_reaper_run_, pconfig->name, APP_TASK_STACK_LED_REAPER, NULL,
+	                                         tskIDLE_PRIORITY + pconfig->priority, led_reaper_stack_, &led_reaper_tcb_);
+	configASSERT(NULL != hreaper);
 }
 
-void led_task_run(void)
+#endif
+
+void led_task_run(void *argument)
 {
 	LedTask_t cmd;
 	while (true)
 	{
 		if (xQueueReceive(led_event_queue, &cmd, portMAX_DELAY) == pdPASS)
 		{
-			if (cmd.state == LED_CMD_ON)
+			latency_trace_stamp(cmd.trace_id, LATENCY_STAGE_LED_QUEUE);
+			if ((cmd.state == LED_CMD_ON) && led_color_is_valid_(cmd.color))
 			{
-				switch (cmd.color) {
-				case LED_COLOR_RED:
-					led_red_set_state(cmd.state);
-					vTaskDelay(pdMS_TO_TICKS(1000));
-					led_red_set_state(LED_CMD_OFF);
-					break;
-				case LED_COLOR_GREEN:
-					led_green_set_state(cmd.state);
-					vTaskDelay(pdMS_TO_TICKS(1000));
-					led_green_set_state(LED_CMD_OFF);
-					break;
-				case LED_COLOR_BLUE:
-					led_blue_set_state(cmd.state);
-					vTaskDelay(pdMS_TO_TICKS(1000));
-					led_blue_set_state(LED_CMD_OFF);
-					break;
-				default:
-					break;
-				}
+#if (1 == LED_AO_CONFIG_USE_PULSE_TIMERS)
+				led_pulse_start_(&cmd);
+#else
+				create_led_task_(&cmd);
+#endif
 			}
 		}
-
-		delete_task_();
 	}
-
 }
 
 /* ============================================================================================ */
@@ -122,37 +388,44 @@ void led_blue_set_state(led_cmd_t cmd)
 
 /* ============================================================================================ */
 
-void create_led_task_( const char *task_name){
-	if (xTaskCreate((TaskFunction_t)led_task_run, task_name, LED_TASK_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL) != pdPASS) {
+void led_ao_init(void)
+{
+	BaseType_t status;
 
-		LOGGER_INFO("Failed to create LED task");
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+	led_event_queue = xQueueCreateStatic(LED_AO_QUEUE_LENGTH, sizeof(LedTask_t),
+	                                     led_event_queue_storage_, &led_event_queue_buffer_);
+#else
+	led_event_queue = xQueueCreate(LED_AO_QUEUE_LENGTH, sizeof(LedTask_t));
+#endif
+	configASSERT(NULL != led_event_queue);
+	bus_subscribe(BUS_SIGNAL_LED, led_event_queue);
 
-	}
-	task_cnt_++;
+#if (1 == LED_AO_CONFIG_USE_PULSE_TIMERS)
+	led_pulse_pool_init_();
+#else
+	led_worker_cache_init_();
+#endif
 
+	status = app_task_create(APP_TASK_ID_LED, led_task_run, NULL, NULL);
+	configASSERT(pdPASS == status);
 }
+
 void create_led_task(LedTask_t payload)
 {
-
-
-	led_event_queue = xQueueCreate(10, sizeof(LedTask_t));
-
-
-	if(pdPASS == xQueueSend(led_event_queue, &payload, 0))
+	if (pdPASS != xQueueSend(led_event_queue, &payload, 0))
 	{
-		if (task_cnt_ < MAX_TASKS){
-			create_led_task_(payload.name);
-		    LOGGER_INFO("New task %s", payload.name);
-		}
-		else{
-
-		LOGGER_INFO("Awaiting for free task...");
-		}
+		LOGGER_ERROR("Error when sending event to queue");
 	}
-    else{
-	  LOGGER_INFO("Error when sending event to queue");
-    }
+}
 
+#if (0 == LED_AO_CONFIG_USE_PULSE_TIMERS)
+void led_admission_stats_get(led_admission_stats_t *pstats)
+{
+	taskENTER_CRITICAL();
+	*pstats = led_admission_stats_;
+	taskEXIT_CRITICAL();
 }
+#endif
 
 /* ============================================================================================ */
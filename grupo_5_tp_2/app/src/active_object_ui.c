@@ -32,6 +32,8 @@
  * @author : Sebastian Bedin <sebabedin@gmail.com>
  */
 
+#define LOGGER_MODULE UI    // Before logger.h
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -43,17 +45,88 @@
 #include "logger.h"
 #include "dwt.h"
 #include "app.h"
+#include "event_bus.h"
+#include "latency_trace.h"
 
 
 QueueHandle_t ui_event_queue;
 
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+static uint8_t ui_event_queue_storage_[UI_EVENT_QUEUE_LENGTH * sizeof(message_t)];
+static StaticQueue_t ui_event_queue_buffer_;
+#endif
+
+/* UI states, UI_STATE_READY handles the button events and UI_STATE_ROOT drops the rest */
+typedef enum
+{
+    UI_STATE_ROOT,
+    UI_STATE_READY,
+    UI_STATE__N
+} ui_state_t;
+
+static void ui_led_pulse_(hsm_t *hsm, const void *pevent);
+
+/* ============================================================================================ */
+
+static const hsm_state_t ui_states_[UI_STATE__N] =
+{
+    [UI_STATE_ROOT]  = { HSM_STATE_NONE, UI_STATE_READY, NULL, NULL, "root" },
+    [UI_STATE_READY] = { UI_STATE_ROOT, HSM_STATE_NONE, NULL, NULL, "ready" },
+};
+
+/* Events are the button types reported by the button task */
+static const hsm_transition_t ui_transitions_[UI_STATE__N * BUTTON_TYPE__N] =
+{
+    [HSM_CELL(BUTTON_TYPE__N, UI_STATE_ROOT, BUTTON_TYPE_NONE)]   = { HSM_TRAN_INTERNAL, NULL, NULL, HSM_STATE_NONE },
+    [HSM_CELL(BUTTON_TYPE__N, UI_STATE_READY, BUTTON_TYPE_PULSE)] = { HSM_TRAN_INTERNAL, NULL, ui_led_pulse_, HSM_STATE_NONE },
+    [HSM_CELL(BUTTON_TYPE__N, UI_STATE_READY, BUTTON_TYPE_SHORT)] = { HSM_TRAN_INTERNAL, NULL, ui_led_pulse_, HSM_STATE_NONE },
+    [HSM_CELL(BUTTON_TYPE__N, UI_STATE_READY, BUTTON_TYPE_LONG)]  = { HSM_TRAN_INTERNAL, NULL, ui_led_pulse_, HSM_STATE_NONE },
+};
+
+static const hsm_config_t ui_hsm_config_ =
+{
+    .states = ui_states_,
+    .transitions = ui_transitions_,
+    .nstates = UI_STATE__N,
+    .nevents = BUTTON_TYPE__N,
+    .initial = UI_STATE_ROOT,
+};
+
+/* LED event published for each button type */
+static const LedTask_t ui_led_payload_[BUTTON_TYPE__N] =
+{
+    [BUTTON_TYPE_PULSE] = { LED_COLOR_RED, LED_CMD_ON, "RED LED Task" },
+    [BUTTON_TYPE_SHORT] = { LED_COLOR_GREEN, LED_CMD_ON, "Green LED Task" },
+    [BUTTON_TYPE_LONG]  = { LED_COLOR_BLUE, LED_CMD_ON, "Blue LED Task" },
+};
+
+static const char * const ui_event_name_[BUTTON_TYPE__N] =
+{
+    [BUTTON_TYPE_PULSE] = "pulse",
+    [BUTTON_TYPE_SHORT] = "short press",
+    [BUTTON_TYPE_LONG]  = "long press",
+};
+
+/* ============================================================================================ */
+
+static void ui_led_pulse_(hsm_t *hsm, const void *pevent)
+{
+    const message_t *pmsg = (const message_t *)pevent;
+    LedTask_t payload = ui_led_payload_[pmsg->button];
+
+    LOGGER_INFO("Button %c %s detected", 'A' + pmsg->id, ui_event_name_[pmsg->button]);
+    payload.trace_id = pmsg->trace_id;
+    latency_trace_stamp(payload.trace_id, LATENCY_STAGE_UI_DISPATCH);
+    bus_publish(BUS_SIGNAL_LED, &payload);
+}
+
 /* ============================================================================================ */
 
 void ui_task_init(UiTask_t *ui_task, QueueHandle_t button_state_queue, LedTask_t *led_task)
 {
     ui_task->button_state_queue = button_state_queue;
     ui_task->led_task = led_task;
-
+    hsm_init(&ui_task->hsm, &ui_hsm_config_, ui_task);
 }
 
 /* ============================================================================================ */
@@ -62,45 +135,12 @@ void ui_task_run(void *argument)
 {
 	UiTask_t* ui_task = (UiTask_t*)argument;
 	message_t message;
-	LedTask_t payload;
     while (true) 
     {
         /* Wait for a button state change */
         if (xQueueReceive(ui_task->button_state_queue, &message, portMAX_DELAY) == pdPASS)
         {
-
-            switch (message.button)
-            {
-                case BUTTON_STATE_PULSE:
-                    LOGGER_INFO("Button pulse detected");
-                    payload.color = LED_COLOR_RED;
-                    payload.state = LED_CMD_ON;
-                    payload.name = "RED LED Task";
-
-                    create_led_task(payload);
-
-                    break;
-                case BUTTON_STATE_SHORT:
-                    LOGGER_INFO("Button short press detected");
-                    payload.color = LED_COLOR_GREEN;
-                    payload.state = LED_CMD_ON;
-                    payload.name = "Green LED Task";
-
-                    create_led_task(payload);
-
-                    break;
-                case BUTTON_STATE_LONG:
-                    LOGGER_INFO("Button long press detected");
-                    payload.color = LED_COLOR_BLUE;
-                    payload.state = LED_CMD_ON;
-                    payload.name = "Blue LED Task";
-
-                    create_led_task(payload);
-
-                    break;
-                default:
-                    break;
-            }
+            hsm_dispatch(&ui_task->hsm, (hsm_event_id_t)message.button, &message);
         }
     }
 }
@@ -114,7 +154,14 @@ void ui_send_message(message_t *pmsg){
 void ui_task_create(UiTask_t *ui_task) 
 {
     /* Create the UI event queue */
-    ui_event_queue = xQueueCreate(10, sizeof(message_t));
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+    ui_event_queue = xQueueCreateStatic(UI_EVENT_QUEUE_LENGTH, sizeof(message_t),
+                                        ui_event_queue_storage_, &ui_event_queue_buffer_);
+#else
+    ui_event_queue = xQueueCreate(UI_EVENT_QUEUE_LENGTH, sizeof(message_t));
+#endif
+    configASSERT(NULL != ui_event_queue);
+    bus_subscribe(BUS_SIGNAL_BUTTON, ui_event_queue);
 
     /* Initialize the UI task */
     ui_task_init(ui_task, ui_event_queue, &led_task);
@@ -122,7 +169,7 @@ void ui_task_create(UiTask_t *ui_task)
     /* Create the UI task */
     BaseType_t status;
 
-    status = xTaskCreate(ui_task_run, "UI Task", configMINIMAL_STACK_SIZE, ui_task, tskIDLE_PRIORITY, NULL);
+    status = app_task_create(APP_TASK_ID_UI, ui_task_run, ui_task, NULL);
     configASSERT(pdPASS == status);
 }
 
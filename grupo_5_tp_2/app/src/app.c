@@ -1,75 +1,161 @@
-/*
- * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions are met:
- *
- * 1. Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- *
- * 2. Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * 3. Neither the name of the copyright holder nor the names of its
- *    contributors may be used to endorse or promote products derived from
- *    this software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
- * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
- * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
- * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
- * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
- * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
- * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
- * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
- * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- * POSSIBILITY OF SUCH DAMAGE.
- *
- * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
- */
-
-/********************** inclusions *******************************************/
-
-#include "app.h"
-
-/********************** macros and definitions *******************************/
-
-/********************** internal data declaration ****************************/
-
-/********************** internal functions declaration ***********************/
-
-/********************** internal data definition *****************************/
-
-
-LedTask_t led_task;
-UiTask_t ui_task;
-
-
-/********************** external data declaration *****************************/
-
-/********************** external functions definition ************************/
-
-void app_init(void)
-{
-    /* Initialize the memory pool */
-    //memory_pool_init(&led_task_pool, &led_task_pool_memory, MAX_LED_TASKS, sizeof(LedTask_t));
-
-    /* Create button task */
-    ui_task.led_task = &led_task;
-
-    ui_task_create(&ui_task);
-    BaseType_t status;
-    status = xTaskCreate(task_button, "Button Task", configMINIMAL_STACK_SIZE, ui_task.button_state_queue, tskIDLE_PRIORITY, NULL);
-    configASSERT(status == pdPASS);
-
-	/* Start scheduler */
-    //vTaskStartScheduler();
-	LOGGER_INFO("app init");
-	cycle_counter_init();
-}
-
-/********************** end of file ******************************************/
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include "app.h"
+
+/********************** macros and definitions *******************************/
+
+/* The timer service task is created by the kernel, its table row has to match FreeRTOSConfig.h */
+_Static_assert(APP_TASK_PRIO_TIMER_SVC == configTIMER_TASK_PRIORITY, "Timer task priority out of sync");
+_Static_assert(APP_TASK_STACK_TIMER_SVC == configTIMER_TASK_STACK_DEPTH, "Timer task stack out of sync");
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+/* Stack and TCB of every task created through app_task_create(), placed as the table says */
+typedef struct
+{
+    StackType_t* pstack;
+    StaticTask_t* ptcb;
+} app_task_buffers_t;
+
+#define APP_TASK_SECTION_SRAM
+#define APP_TASK_SECTION_CCM                    __attribute__((section(".ccmbss")))
+
+#define APP_TASK_STORAGE_SRAM(id)\
+    static StackType_t app_task_stack_##id[APP_TASK_STACK_##id] APP_TASK_SECTION_SRAM;\
+    static StaticTask_t app_task_tcb_##id;
+#define APP_TASK_STORAGE_CCM(id)\
+    static StackType_t app_task_stack_##id[APP_TASK_STACK_##id] APP_TASK_SECTION_CCM;\
+    static StaticTask_t app_task_tcb_##id;
+#define APP_TASK_STORAGE_EXTERNAL(id)
+
+#define APP_TASK_BUFFERS_SRAM(id)               [APP_TASK_ID_##id] = { app_task_stack_##id, &app_task_tcb_##id },
+#define APP_TASK_BUFFERS_CCM(id)                [APP_TASK_ID_##id] = { app_task_stack_##id, &app_task_tcb_##id },
+#define APP_TASK_BUFFERS_EXTERNAL(id)
+
+#define APP_TASK_STORAGE_(id, name, period_ms, wcet_us, priority, stack_words, placement)\
+    APP_TASK_STORAGE_##placement(id)
+#define APP_TASK_BUFFERS_(id, name, period_ms, wcet_us, priority, stack_words, placement)\
+    APP_TASK_BUFFERS_##placement(id)
+
+APP_TASK_TABLE(APP_TASK_STORAGE_)
+
+static const app_task_buffers_t app_task_buffers_[APP_TASK__N] =
+{
+    APP_TASK_TABLE(APP_TASK_BUFFERS_)
+};
+#endif
+
+
+LedTask_t led_task;
+UiTask_t ui_task;
+
+#define APP_TASK_CONFIG_(id, name, period_ms, wcet_us, priority, stack_words, placement)\
+    [APP_TASK_ID_##id] = { (name), (period_ms), (wcet_us), (priority), (stack_words), APP_TASK_MEM_##placement },
+
+const app_task_config_t app_task_config[APP_TASK__N] =
+{
+    APP_TASK_TABLE(APP_TASK_CONFIG_)
+};
+
+
+/********************** external data declaration *****************************/
+
+/********************** external functions definition ************************/
+
+void app_init(void)
+{
+    /* Timestamps of the log, the latency trace and the probes. Zeroes CYCCNT, so it goes
+     * before anything reading cycle_counter_get64() */
+    cycle_counter_init();
+
+    /* Start draining the log ring, logging before this point is buffered */
+    logger_init();
+
+    /* Initialize the event bus before any active object subscribes */
+    bus_init();
+
+    /* Create the LED active object */
+    led_ao_init();
+
+    /* Create button task */
+    ui_task.led_task = &led_task;
+
+    ui_task_create(&ui_task);
+    BaseType_t status;
+    status = app_task_create(APP_TASK_ID_BUTTON, task_button, ui_task.button_state_queue, NULL);
+    configASSERT(status == pdPASS);
+
+	/* Start scheduler */
+    //vTaskStartScheduler();
+	prof_init();
+
+    /* Statistical profile, dump pc_sampler and feed it to tools/pc_profile.py */
+    pc_sampler_init();
+
+    /* Stack headroom of every task, with recommended sizes for the task table */
+    stack_mon_init();
+
+	LOGGER_INFO("app init");
+}
+
+BaseType_t app_task_create(app_task_id_t id, TaskFunction_t func, void* argument, TaskHandle_t* phandle)
+{
+    const app_task_config_t* pconfig = &app_task_config[id];
+
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+    const app_task_buffers_t* pbuffers = &app_task_buffers_[id];
+    configASSERT(NULL != pbuffers->pstack);
+
+    TaskHandle_t handle = xTaskCreateStatic(func, pconfig->name, pconfig->stack_words, argument,
+                                            tskIDLE_PRIORITY + pconfig->priority, pbuffers->pstack, pbuffers->ptcb);
+    if (NULL != phandle)
+    {
+        *phandle = handle;
+    }
+    return (NULL != handle) ? pdPASS : pdFAIL;
+#else
+    return xTaskCreate(func, pconfig->name, pconfig->stack_words, argument,
+                       tskIDLE_PRIORITY + pconfig->priority, phandle);
+#endif
+}
+
+/********************** end of file ******************************************/
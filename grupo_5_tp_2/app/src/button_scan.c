@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : button_scan.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "button_scan.h"
+
+/********************** macros and definitions *******************************/
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+static int button_scan_port_index_(button_scan_t* hscan, GPIO_TypeDef* port)
+{
+  for(size_t i = 0; i < hscan->nports; ++i)
+  {
+    if(port == hscan->port[i])
+    {
+      return (int)i;
+    }
+  }
+  if(BUTTON_SCAN_CONFIG_MAX_PORTS <= hscan->nports)
+  {
+    return -1;
+  }
+  hscan->port[hscan->nports] = port;
+  hscan->mask[hscan->nports] = 0;
+  return (int)hscan->nports++;
+}
+
+/* One IDR read per port, port i lands on bits [16 i, 16 i + 15] */
+static inline uint32_t button_scan_sample_(const button_scan_t* hscan)
+{
+  uint32_t sample = 0;
+  for(size_t i = 0; i < hscan->nports; ++i)
+  {
+    sample |= (uint32_t)(hscan->port[i]->IDR & hscan->mask[i]) << (16 * i);
+  }
+  return sample ^ hscan->invert;
+}
+
+/********************** external functions definition ************************/
+
+bool button_scan_init(button_scan_t* hscan, const button_scan_input_t* inputs, size_t ninputs)
+{
+  hscan->nports = 0;
+  hscan->invert = 0;
+  hscan->ninputs = 0;
+  if(BUTTON_SCAN_CONFIG_MAX_INPUTS < ninputs)
+  {
+    return false;
+  }
+
+  uint32_t used = 0;
+  for(size_t i = 0; i < ninputs; ++i)
+  {
+    int port = button_scan_port_index_(hscan, inputs[i].port);
+    if(port < 0)
+    {
+      return false;
+    }
+    uint32_t bit = (uint32_t)inputs[i].pin << (16 * port);
+    /* Boards with fewer buttons alias several inputs to one pin, only the first one reports it */
+    if(0 != (used & bit))
+    {
+      hscan->input_bit[i] = 0;
+      continue;
+    }
+    used |= bit;
+    hscan->mask[port] |= inputs[i].pin;
+    if(GPIO_PIN_RESET == inputs[i].pressed)
+    {
+      hscan->invert |= bit;
+    }
+    hscan->input_bit[i] = bit;
+  }
+  hscan->ninputs = ninputs;
+
+  /* Start settled on the current levels, no events at boot */
+  hscan->state = button_scan_sample_(hscan);
+  hscan->cnt0 = 0;
+  hscan->cnt1 = 0;
+  return true;
+}
+
+uint32_t button_scan_update(button_scan_t* hscan)
+{
+  uint32_t delta = button_scan_sample_(hscan) ^ hscan->state;
+
+  /* Counters count up while a bit differs from its state and reset when it agrees,
+   * a bit toggles when its counter wraps */
+  hscan->cnt1 = (hscan->cnt1 ^ hscan->cnt0) & delta;
+  hscan->cnt0 = ~hscan->cnt0 & delta;
+  uint32_t changed = delta & ~(hscan->cnt0 | hscan->cnt1);
+  hscan->state ^= changed;
+  return changed;
+}
+
+/********************** end of file ******************************************/
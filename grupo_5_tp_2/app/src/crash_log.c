@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : crash_log.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+
+#include "crash_log.h"
+#include "logger.h"
+
+/********************** macros and definitions *******************************/
+
+#if 0 != (CRASH_LOG_CONFIG_SIZE & (CRASH_LOG_CONFIG_SIZE - 1))
+#error "CRASH_LOG_CONFIG_SIZE must be a power of two"
+#endif
+
+#define CRASH_LOG_FNV_BASIS_            (2166136261UL)
+#define CRASH_LOG_FNV_PRIME_            (16777619UL)
+
+/********************** internal data declaration ****************************/
+
+typedef struct
+{
+  crash_log_header_t header;
+  char data[CRASH_LOG_CONFIG_SIZE];
+} crash_log_t;
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+/* Neither loaded nor cleared by the startup code, survives a warm reset */
+__attribute__((section(".noinit"))) static crash_log_t crash_log_;
+
+static bool crash_log_pending_;
+static bool crash_log_sealed_;
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+static uint32_t crash_log_hash_(uint32_t hash, const void* data, size_t len)
+{
+  const uint8_t* p = data;
+  while(0 < len--)
+  {
+    hash = (hash ^ *p++) * CRASH_LOG_FNV_PRIME_;
+  }
+  return hash;
+}
+
+static uint32_t crash_log_checksum_(void)
+{
+  uint32_t hash = crash_log_hash_(CRASH_LOG_FNV_BASIS_, &crash_log_.header, offsetof(crash_log_header_t, checksum));
+  return crash_log_hash_(hash, crash_log_.data, sizeof(crash_log_.data));
+}
+
+static void crash_log_reset_(void)
+{
+  memset(&crash_log_.header, 0, sizeof(crash_log_.header));
+  crash_log_.header.magic = CRASH_LOG_MAGIC;
+  crash_log_.header.size = CRASH_LOG_CONFIG_SIZE;
+}
+
+static void crash_log_copy_name_(char* dst, const char* src)
+{
+  size_t i = 0;
+  for(; (NULL != src) && ('\0' != src[i]) && (i < (CRASH_LOG_WHERE_LEN - 1)); ++i)
+  {
+    dst[i] = src[i];
+  }
+  dst[i] = '\0';
+}
+
+/********************** external functions definition ************************/
+
+void crash_log_init(void)
+{
+  crash_log_header_t* pheader = &crash_log_.header;
+  crash_log_pending_ = (CRASH_LOG_MAGIC == pheader->magic) &&
+                       (CRASH_LOG_CONFIG_SIZE == pheader->size) &&
+                       (CRASH_LOG_REASON_NONE != pheader->reason) &&
+                       (crash_log_checksum_() == pheader->checksum);
+  if(!crash_log_pending_)
+  {
+    crash_log_reset_();
+  }
+}
+
+void crash_log_write(const char* buf, size_t len)
+{
+  if(crash_log_pending_ || crash_log_sealed_)
+  {
+    return;
+  }
+
+  uint32_t head = crash_log_.header.head;
+  for(size_t i = 0; i < len; ++i)
+  {
+    crash_log_.data[(head + i) % CRASH_LOG_CONFIG_SIZE] = buf[i];
+  }
+  crash_log_.header.head = head + len;
+}
+
+void crash_log_seal(crash_log_reason_t reason, const char* where, uint32_t info)
+{
+  taskDISABLE_INTERRUPTS();
+  if(crash_log_sealed_)
+  {
+    return;
+  }
+
+  /* A log still pending from the previous crash is worth more than this one's */
+  if(!crash_log_pending_)
+  {
+    logger_crash_flush();
+
+    crash_log_header_t* pheader = &crash_log_.header;
+    pheader->reason = reason;
+    pheader->info = info;
+    crash_log_copy_name_(pheader->where, where);
+    crash_log_copy_name_(pheader->task, (taskSCHEDULER_NOT_STARTED != xTaskGetSchedulerState()) ? pcTaskGetName(NULL) : NULL);
+    pheader->checksum = crash_log_checksum_();
+  }
+  crash_log_sealed_ = true;
+
+#if 1 == CRASH_LOG_CONFIG_RESET
+  NVIC_SystemReset();
+#endif
+}
+
+void crash_log_assert(const char* file, int line)
+{
+  const char* name = strrchr(file, '/');
+  crash_log_seal(CRASH_LOG_REASON_ASSERT, (NULL != name) ? (name + 1) : file, (uint32_t)line);
+}
+
+const crash_log_header_t* crash_log_pending(void)
+{
+  return crash_log_pending_ ? &crash_log_.header : NULL;
+}
+
+void crash_log_dump(void (*print)(const char* buf, size_t len))
+{
+  if(!crash_log_pending_)
+  {
+    return;
+  }
+
+  uint32_t head = crash_log_.header.head;
+  uint32_t len = (CRASH_LOG_CONFIG_SIZE < head) ? CRASH_LOG_CONFIG_SIZE : head;
+  uint32_t start = head - len;
+  if(0 != start)
+  {
+    /* Wrapped, the oldest text message was partly overwritten, a tokenized decoder resyncs by itself */
+#if 0 == LOGGER_CONFIG_TOKENIZED
+    while((0 < len) && ('\n' != crash_log_.data[start % CRASH_LOG_CONFIG_SIZE]))
+    {
+      start++;
+      len--;
+    }
+    if(0 < len)
+    {
+      start++;
+      len--;
+    }
+#endif
+  }
+
+  uint32_t offset = start % CRASH_LOG_CONFIG_SIZE;
+  uint32_t first = CRASH_LOG_CONFIG_SIZE - offset;
+  if(len < first)
+  {
+    first = len;
+  }
+  print(&crash_log_.data[offset], first);
+  if(first < len)
+  {
+    print(&crash_log_.data[0], len - first);
+  }
+
+  crash_log_reset_();
+  crash_log_pending_ = false;
+}
+
+/********************** end of file ******************************************/
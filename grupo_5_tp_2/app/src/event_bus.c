@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : event_bus.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "event_bus.h"
+#include "prof.h"
+
+/********************** macros and definitions *******************************/
+
+/********************** internal data declaration ****************************/
+
+typedef struct
+{
+  uint32_t subscribers;     /* Bit i set: subscriber_queue_[i] receives the signal */
+  bus_topic_stats_t stats;
+} bus_topic_t;
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+static QueueHandle_t subscriber_queue_[BUS_CONFIG_MAX_SUBSCRIBERS];
+static uint32_t subscriber_cnt_;
+static bus_topic_t topic_[BUS_SIGNAL__N];
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+static int bus_subscriber_find_(QueueHandle_t queue)
+{
+  for(uint32_t i = 0; i < subscriber_cnt_; ++i)
+  {
+    if(queue == subscriber_queue_[i])
+    {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+/********************** external functions definition ************************/
+
+void bus_init(void)
+{
+  subscriber_cnt_ = 0;
+  for(uint32_t i = 0; i < BUS_SIGNAL__N; ++i)
+  {
+    topic_[i].subscribers = 0;
+    topic_[i].stats.delivered = 0;
+    topic_[i].stats.dropped = 0;
+  }
+}
+
+bool bus_subscribe(bus_signal_t signal, QueueHandle_t queue)
+{
+  bool ret = false;
+  if((BUS_SIGNAL__N <= signal) || (NULL == queue))
+  {
+    return ret;
+  }
+
+  portENTER_CRITICAL();
+  int id = bus_subscriber_find_(queue);
+  if((id < 0) && (subscriber_cnt_ < BUS_CONFIG_MAX_SUBSCRIBERS))
+  {
+    id = (int)subscriber_cnt_++;
+    subscriber_queue_[id] = queue;
+  }
+  if(0 <= id)
+  {
+    topic_[signal].subscribers |= (1UL << id);
+    ret = true;
+  }
+  portEXIT_CRITICAL();
+  return ret;
+}
+
+uint32_t bus_publish(bus_signal_t signal, const void* pevent)
+{
+  if(BUS_SIGNAL__N <= signal)
+  {
+    return 0;
+  }
+
+  bus_topic_t* ptopic = &topic_[signal];
+  uint32_t mask = ptopic->subscribers;
+  uint32_t delivered = 0;
+  uint32_t dropped = 0;
+
+  /* Each subscriber gets its own copy, a full queue never blocks the publisher */
+  while(0 != mask)
+  {
+    uint32_t id = (uint32_t)__builtin_ctz(mask);
+    mask &= (mask - 1);
+    PROF_BEGIN(BUS_QUEUE_SEND);
+    BaseType_t sent = xQueueSend(subscriber_queue_[id], pevent, 0);
+    PROF_END(BUS_QUEUE_SEND);
+    if(pdPASS == sent)
+    {
+      delivered++;
+    }
+    else
+    {
+      dropped++;
+    }
+  }
+
+  portENTER_CRITICAL();
+  ptopic->stats.delivered += delivered;
+  ptopic->stats.dropped += dropped;
+  portEXIT_CRITICAL();
+  return delivered;
+}
+
+void bus_stats_get(bus_signal_t signal, bus_topic_stats_t* pstats)
+{
+  if(BUS_SIGNAL__N <= signal)
+  {
+    return;
+  }
+  portENTER_CRITICAL();
+  *pstats = topic_[signal].stats;
+  portEXIT_CRITICAL();
+}
+
+/********************** end of file ******************************************/
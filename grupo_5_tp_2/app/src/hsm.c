@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : hsm.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "hsm.h"
+
+/********************** macros and definitions *******************************/
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+static inline hsm_state_id_t hsm_parent_(const hsm_t* hsm, hsm_state_id_t state)
+{
+  return hsm->config->states[state].parent;
+}
+
+static bool hsm_is_ancestor_or_self_(const hsm_t* hsm, hsm_state_id_t ancestor, hsm_state_id_t state)
+{
+  for(hsm_state_id_t s = state; HSM_STATE_NONE != s; s = hsm_parent_(hsm, s))
+  {
+    if(ancestor == s)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Deepest state that is neither exited nor entered by a source -> target transition */
+static hsm_state_id_t hsm_lca_(const hsm_t* hsm, hsm_state_id_t source, hsm_state_id_t target)
+{
+  if(hsm_is_ancestor_or_self_(hsm, target, source))
+  {
+    return hsm_parent_(hsm, target);
+  }
+  for(hsm_state_id_t s = source; HSM_STATE_NONE != s; s = hsm_parent_(hsm, s))
+  {
+    if(hsm_is_ancestor_or_self_(hsm, s, target))
+    {
+      return s;
+    }
+  }
+  return HSM_STATE_NONE;
+}
+
+/* Enters every state below lca down to target, then follows the initial children */
+static void hsm_enter_(hsm_t* hsm, hsm_state_id_t lca, hsm_state_id_t target, const void* pevent)
+{
+  const hsm_state_t* states = hsm->config->states;
+  hsm_state_id_t path[HSM_CONFIG_MAX_DEPTH];
+  uint8_t depth = 0;
+
+  for(hsm_state_id_t s = target; lca != s; s = states[s].parent)
+  {
+    if(HSM_CONFIG_MAX_DEPTH <= depth)
+    {
+      break;
+    }
+    path[depth++] = s;
+  }
+  while(0 < depth)
+  {
+    hsm_state_id_t s = path[--depth];
+    if(NULL != states[s].entry)
+    {
+      states[s].entry(hsm, pevent);
+    }
+  }
+
+  hsm->state = target;
+  while(HSM_STATE_NONE != states[hsm->state].initial)
+  {
+    hsm->state = states[hsm->state].initial;
+    if(NULL != states[hsm->state].entry)
+    {
+      states[hsm->state].entry(hsm, pevent);
+    }
+  }
+}
+
+static void hsm_exit_(hsm_t* hsm, hsm_state_id_t lca, const void* pevent)
+{
+  const hsm_state_t* states = hsm->config->states;
+  for(hsm_state_id_t s = hsm->state; lca != s; s = states[s].parent)
+  {
+    if(NULL != states[s].exit)
+    {
+      states[s].exit(hsm, pevent);
+    }
+  }
+}
+
+/********************** external functions definition ************************/
+
+void hsm_init(hsm_t* hsm, const hsm_config_t* config, void* context)
+{
+  hsm->config = config;
+  hsm->context = context;
+  hsm->state = HSM_STATE_NONE;
+  hsm_enter_(hsm, HSM_STATE_NONE, config->initial, NULL);
+}
+
+bool hsm_dispatch(hsm_t* hsm, hsm_event_id_t event, const void* pevent)
+{
+  const hsm_config_t* config = hsm->config;
+  if(config->nevents <= event)
+  {
+    return false;
+  }
+
+  /* One table lookup per nesting level, the leaf state is tried first */
+  for(hsm_state_id_t s = hsm->state; HSM_STATE_NONE != s; s = config->states[s].parent)
+  {
+    const hsm_transition_t* ptran = &config->transitions[HSM_CELL(config->nevents, s, event)];
+    if(HSM_TRAN_NONE == ptran->kind)
+    {
+      continue;
+    }
+    if((NULL != ptran->guard) && !ptran->guard(hsm, pevent))
+    {
+      continue;
+    }
+
+    if(HSM_TRAN_INTERNAL == ptran->kind)
+    {
+      if(NULL != ptran->action)
+      {
+        ptran->action(hsm, pevent);
+      }
+    }
+    else
+    {
+      hsm_state_id_t lca = hsm_lca_(hsm, s, ptran->target);
+      hsm_exit_(hsm, lca, pevent);
+      if(NULL != ptran->action)
+      {
+        ptran->action(hsm, pevent);
+      }
+      hsm_enter_(hsm, lca, ptran->target, pevent);
+    }
+    return true;
+  }
+  return false;
+}
+
+/********************** end of file ******************************************/
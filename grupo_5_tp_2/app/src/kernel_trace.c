@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : kernel_trace.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "dwt.h"
+#include "kernel_trace.h"
+
+/********************** macros and definitions *******************************/
+
+#if 0 != (KERNEL_TRACE_CONFIG_RECORDS & (KERNEL_TRACE_CONFIG_RECORDS - 1))
+#error "KERNEL_TRACE_CONFIG_RECORDS must be a power of two"
+#endif
+
+#if (1 != configUSE_TRACE_FACILITY)
+#error "The kernel trace numbers tasks and queues through configUSE_TRACE_FACILITY"
+#endif
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+static bool kernel_trace_running_ = true;
+static uint64_t kernel_trace_last_;
+static UBaseType_t kernel_trace_tasks_;
+static UBaseType_t kernel_trace_queues_;
+
+/********************** external data definition *****************************/
+
+kernel_trace_t kernel_trace =
+{
+  .magic = KERNEL_TRACE_MAGIC,
+  .version = KERNEL_TRACE_VERSION,
+  .record_size = sizeof(kernel_trace_record_t),
+  .capacity = KERNEL_TRACE_CONFIG_RECORDS,
+  .names = KERNEL_TRACE_CONFIG_NAMES,
+  .name_len = KERNEL_TRACE_NAME_LEN,
+};
+
+/********************** internal functions definition ************************/
+
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+
+static void kernel_trace_put_(uint32_t delta, uint8_t event, uint8_t flags, uint16_t object)
+{
+  kernel_trace_record_t* precord = &kernel_trace.record[kernel_trace.written % KERNEL_TRACE_CONFIG_RECORDS];
+  if(KERNEL_TRACE_CONFIG_RECORDS <= kernel_trace.written)
+  {
+    /* The oldest record goes, the next one's delta is relative to it */
+    kernel_trace.base += precord->delta;
+  }
+  precord->delta = delta;
+  precord->event = event;
+  precord->flags = flags;
+  precord->object = object;
+  kernel_trace.written++;
+}
+
+/*
+ * Some hooks run with interrupts enabled (queue creation, blocking under vTaskSuspendAll()),
+ * a FromISR call could land in the middle of the write
+ */
+static void kernel_trace_write_(kernel_trace_event_t event, uint8_t flags, UBaseType_t object)
+{
+  if(!kernel_trace_running_)
+  {
+    return;
+  }
+
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  if(0 == kernel_trace.clock_hz)
+  {
+    kernel_trace.clock_hz = SystemCoreClock;
+  }
+
+  uint64_t now = cycle_counter_get64();
+  uint64_t delta = now - kernel_trace_last_;
+  kernel_trace_last_ = now;
+  while(UINT32_MAX < delta)
+  {
+    kernel_trace_put_(UINT32_MAX, KERNEL_TRACE_EVENT_GAP, 0, 0);
+    delta -= UINT32_MAX;
+  }
+  kernel_trace_put_((uint32_t)delta, (uint8_t)event, flags, (uint16_t)object);
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+static inline UBaseType_t kernel_trace_task_number_(void* htask)
+{
+  return uxTaskGetTaskNumber((TaskHandle_t)htask);
+}
+
+#endif
+
+/* Called inside the kernel's critical section around the new task */
+static UBaseType_t kernel_trace_task_numbering_(void* htask)
+{
+  vTaskSetTaskNumber((TaskHandle_t)htask, ++kernel_trace_tasks_);
+  return kernel_trace_tasks_;
+}
+
+/********************** external functions definition ************************/
+
+void kernel_trace_task_switched_in(void* htask)
+{
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  kernel_trace_write_(KERNEL_TRACE_EVENT_TASK_SWITCHED_IN, 0, kernel_trace_task_number_(htask));
+#endif
+}
+
+void kernel_trace_task_switched_out(void* htask)
+{
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  kernel_trace_write_(KERNEL_TRACE_EVENT_TASK_SWITCHED_OUT, 0, kernel_trace_task_number_(htask));
+#endif
+}
+
+void kernel_trace_task_create(void* htask)
+{
+  /* The kernel only numbers TCBs for itself, numbered here from 1, recycled TCBs get a new number */
+  UBaseType_t number = kernel_trace_task_numbering_(htask);
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  char* name = kernel_trace.name[number % KERNEL_TRACE_CONFIG_NAMES];
+  strncpy(name, pcTaskGetName((TaskHandle_t)htask), KERNEL_TRACE_NAME_LEN - 1);
+  name[KERNEL_TRACE_NAME_LEN - 1] = '\0';
+  kernel_trace_write_(KERNEL_TRACE_EVENT_TASK_CREATE, 0, number);
+#else
+  (void)number;
+#endif
+}
+
+void kernel_trace_task_delete(void* htask)
+{
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  kernel_trace_write_(KERNEL_TRACE_EVENT_TASK_DELETE, 0, kernel_trace_task_number_(htask));
+#endif
+}
+
+void kernel_trace_queue_create(void* hqueue)
+{
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  /* The kernel leaves queue numbers at 0, numbered here in creation order from 1. Queues
+   * are created with interrupts enabled */
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  UBaseType_t number = ++kernel_trace_queues_;
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+  vQueueSetQueueNumber((QueueHandle_t)hqueue, number);
+  kernel_trace_write_(KERNEL_TRACE_EVENT_QUEUE_CREATE, 0, number);
+#endif
+}
+
+void kernel_trace_queue_send(void* hqueue, int from_isr)
+{
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  kernel_trace_write_(KERNEL_TRACE_EVENT_QUEUE_SEND, from_isr ? KERNEL_TRACE_FLAG_ISR : 0,
+                      uxQueueGetQueueNumber((QueueHandle_t)hqueue));
+#endif
+}
+
+void kernel_trace_queue_receive(void* hqueue, int from_isr)
+{
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  kernel_trace_write_(KERNEL_TRACE_EVENT_QUEUE_RECEIVE, from_isr ? KERNEL_TRACE_FLAG_ISR : 0,
+                      uxQueueGetQueueNumber((QueueHandle_t)hqueue));
+#endif
+}
+
+void kernel_trace_queue_block(void* hqueue, int receive)
+{
+#if (1 == KERNEL_TRACE_CONFIG_ENABLE)
+  kernel_trace_write_(receive ? KERNEL_TRACE_EVENT_QUEUE_BLOCK_RECEIVE : KERNEL_TRACE_EVENT_QUEUE_BLOCK_SEND, 0,
+                      uxQueueGetQueueNumber((QueueHandle_t)hqueue));
+#endif
+}
+
+void kernel_trace_stop(void)
+{
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  kernel_trace_running_ = false;
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+void kernel_trace_start(void)
+{
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  kernel_trace_last_ = cycle_counter_get64();
+  kernel_trace.base = kernel_trace_last_;
+  kernel_trace.written = 0;
+  kernel_trace.clock_hz = SystemCoreClock;
+  kernel_trace_running_ = true;
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/********************** end of file ******************************************/
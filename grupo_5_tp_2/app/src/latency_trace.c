@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : latency_trace.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#define LOGGER_MODULE   LATENCY    /* Before logger.h */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+#include "latency_trace.h"
+
+#if (1 == LATENCY_TRACE_CONFIG_ENABLE)
+
+/********************** macros and definitions *******************************/
+
+/* Histogram 0 covers the whole path, histogram s covers stage s - 1 to stage s */
+#define LATENCY_HIST__N_                (LATENCY_STAGE__N)
+
+/********************** internal data declaration ****************************/
+
+typedef struct
+{
+  uint32_t trace_id;
+  uint32_t stamped;                 /* Bit s: cycles[s] belongs to this event */
+  uint32_t cycles[LATENCY_STAGE__N];
+} latency_record_t;
+
+typedef struct
+{
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+  uint32_t bucket[LATENCY_TRACE_CONFIG_BUCKETS];
+} latency_hist_t;
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+static latency_record_t record_[LATENCY_TRACE_CONFIG_SLOTS];
+static latency_hist_t hist_[LATENCY_HIST__N_];
+static uint32_t next_id_ = LATENCY_TRACE_ID_NONE;
+
+static const char* const hist_name_[LATENCY_HIST__N_] =
+{
+  "total",
+  "classify",
+  "ui",
+  "led queue",
+  "led on",
+};
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+/* Bucket b holds latencies in [2^(b-1), 2^b) us, bucket 0 holds 0 us */
+static uint32_t latency_bucket_(uint32_t us)
+{
+  uint32_t b = (0 == us) ? 0 : (32 - (uint32_t)__builtin_clz(us));
+  return (b < LATENCY_TRACE_CONFIG_BUCKETS) ? b : (LATENCY_TRACE_CONFIG_BUCKETS - 1);
+}
+
+static void latency_hist_add_(latency_hist_t* phist, uint32_t cycles)
+{
+  uint32_t us = cycles / cycles_per_us;
+
+  if((0 == phist->count) || (us < phist->min_us))
+  {
+    phist->min_us = us;
+  }
+  if(phist->max_us < us)
+  {
+    phist->max_us = us;
+  }
+  phist->sum_us += us;
+  phist->count++;
+  phist->bucket[latency_bucket_(us)]++;
+}
+
+/* Upper bound, in us, of the bucket holding the given percentile */
+static uint32_t latency_percentile_(const latency_hist_t* phist, uint32_t percent)
+{
+  uint32_t rank = ((phist->count * percent) + 99) / 100;
+  uint32_t acc = 0;
+  for(uint32_t b = 0; b < LATENCY_TRACE_CONFIG_BUCKETS; ++b)
+  {
+    acc += phist->bucket[b];
+    if(rank <= acc)
+    {
+      return (0 == b) ? 0 : ((1UL << b) - 1);
+    }
+  }
+  return phist->max_us;
+}
+
+static void latency_record_close_(const latency_record_t* precord)
+{
+  const uint32_t* cycles = precord->cycles;
+
+  /* Unsigned differences stay right across a CYCCNT wrap */
+  latency_hist_add_(&hist_[0], cycles[LATENCY_STAGE__N - 1] - cycles[0]);
+  for(uint32_t s = 1; s < LATENCY_STAGE__N; ++s)
+  {
+    uint32_t both = (1UL << s) | (1UL << (s - 1));
+    if(both == (precord->stamped & both))
+    {
+      latency_hist_add_(&hist_[s], cycles[s] - cycles[s - 1]);
+    }
+  }
+}
+
+/********************** external functions definition ************************/
+
+uint32_t latency_trace_begin(uint32_t read_cycles)
+{
+  taskENTER_CRITICAL();
+  if(LATENCY_TRACE_ID_NONE == ++next_id_)
+  {
+    ++next_id_;
+  }
+  uint32_t trace_id = next_id_;
+  latency_record_t* precord = &record_[trace_id % LATENCY_TRACE_CONFIG_SLOTS];
+  /* A reused slot still holds the stamps of an event that never closed */
+  *precord = (latency_record_t){0};
+  precord->trace_id = trace_id;
+  precord->stamped = 1UL << LATENCY_STAGE_BUTTON_READ;
+  precord->cycles[LATENCY_STAGE_BUTTON_READ] = read_cycles;
+  taskEXIT_CRITICAL();
+  return trace_id;
+}
+
+void latency_trace_stamp(uint32_t trace_id, latency_stage_t stage)
+{
+  uint32_t now = cycle_counter_get();
+  if((LATENCY_TRACE_ID_NONE == trace_id) || (LATENCY_STAGE__N <= stage))
+  {
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  latency_record_t* precord = &record_[trace_id % LATENCY_TRACE_CONFIG_SLOTS];
+  /* The slot may already be reused by a newer event */
+  if(trace_id == precord->trace_id)
+  {
+    precord->cycles[stage] = now;
+    precord->stamped |= 1UL << stage;
+    if((LATENCY_STAGE__N - 1) == stage)
+    {
+      latency_record_close_(precord);
+      precord->trace_id = LATENCY_TRACE_ID_NONE;
+    }
+  }
+  taskEXIT_CRITICAL();
+}
+
+void latency_trace_report(void)
+{
+  for(uint32_t h = 0; h < LATENCY_HIST__N_; ++h)
+  {
+    latency_hist_t hist;
+    taskENTER_CRITICAL();
+    hist = hist_[h];
+    taskEXIT_CRITICAL();
+
+    if(0 == hist.count)
+    {
+      continue;
+    }
+    LOGGER_REPORT("latency %s: n=%lu min=%lu avg=%lu max=%lu us", hist_name_[h], (unsigned long)hist.count,
+                  (unsigned long)hist.min_us, (unsigned long)(hist.sum_us / hist.count), (unsigned long)hist.max_us);
+    LOGGER_REPORT("latency %s: p50<=%lu p90<=%lu p99<=%lu us", hist_name_[h],
+                  (unsigned long)latency_percentile_(&hist, 50), (unsigned long)latency_percentile_(&hist, 90),
+                  (unsigned long)latency_percentile_(&hist, 99));
+  }
+}
+
+#endif
+
+/********************** end of file ******************************************/
@@ -37,42 +37,774 @@
 
 /********************** inclusions *******************************************/
 
+#define LOGGER_MODULE   LOGGER    /* Before logger.h */
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdarg.h>
 #include <string.h>
 
 #include "main.h"
 #include "cmsis_os.h"
 
 #include "logger.h"
+#include "logger_format.h"
+#include "crash_log.h"
+#include "app.h"
+#include "dwt.h"
 
 /********************** macros and definitions *******************************/
 
+#if 0 != (LOGGER_CONFIG_SLOTS & (LOGGER_CONFIG_SLOTS - 1))
+#error "LOGGER_CONFIG_SLOTS must be a power of two"
+#endif
+
+#if 0 != (LOGGER_CONFIG_CHANNEL_SLOTS & (LOGGER_CONFIG_CHANNEL_SLOTS - 1))
+#error "LOGGER_CONFIG_CHANNEL_SLOTS must be a power of two"
+#endif
+
+#if (32 < LOGGER_CONFIG_CHANNELS) || (configNUM_THREAD_LOCAL_STORAGE_POINTERS <= LOGGER_CONFIG_TLS_INDEX)
+#error "Per task log channels need a thread local storage pointer and at most 32 channels"
+#endif
+
+#define LOGGER_CHANNEL_ALL_             ((uint32_t)(((uint64_t)1 << LOGGER_CONFIG_CHANNELS) - 1))
+
+#define LOGGER_TOKEN_HEADER_LEN_        (10)
+#if LOGGER_CONFIG_MAXLEN < (LOGGER_TOKEN_HEADER_LEN_ + (4 * LOGGER_TOKEN_MAX_ARGS))
+#error "LOGGER_CONFIG_MAXLEN can't hold a tokenized record"
+#endif
+
+#if (0 == LOGGER_CONFIG_SITE_BURST) || (UINT8_MAX < LOGGER_CONFIG_SITE_BURST)
+#error "LOGGER_CONFIG_SITE_BURST must fit a site's token count"
+#endif
+
+#define LOGGER_FNV_BASIS_               (2166136261UL)
+#define LOGGER_FNV_PRIME_               (16777619UL)
+
 /********************** internal data declaration ****************************/
 
+/*
+ * Shared bounded MPMC ring, for ISRs, code running before the scheduler and tasks left
+ * without a channel. Vyukov sequence: slot of position pos is free while its sequence is
+ * pos, written at pos + 1 and released to the next lap at pos + SLOTS. SLOTS divides 2^32,
+ * so it holds across the wrap of the positions. Each slot keeps its sequence minus its
+ * index, everything starts at zero and the ring works before logger_init().
+ */
+typedef struct
+{
+	uint32_t seq;           /* Sequence minus the slot index */
+	uint32_t timestamp;     /* DWT cycles, the drain merges by it */
+	uint16_t len;
+	char msg[LOGGER_CONFIG_MAXLEN];
+} logger_slot_t;
+
+/* Single producer ring owned by one task through its thread local storage pointer */
+typedef struct
+{
+	logger_slot_t slot[LOGGER_CONFIG_CHANNEL_SLOTS];
+	uint32_t head;          /* Written by the owner only */
+	uint32_t tail;          /* Written by the drain only */
+	bool orphan;            /* Owner deleted, freed once drained */
+} logger_channel_t;
+
+/* Where a record is being written */
+typedef struct
+{
+	logger_slot_t* pslot;
+	logger_channel_t* pchannel;
+	uint32_t pos;
+} logger_ticket_t;
+
 /********************** internal functions declaration ***********************/
 
+static void logger_site_sweep_(void);
+
 /********************** internal data definition *****************************/
 
+static logger_slot_t logger_ring_[LOGGER_CONFIG_SLOTS];
+static uint32_t logger_head_;
+static uint32_t logger_tail_;
+static uint32_t logger_dropped_;
+static uint32_t logger_truncated_;
+static TaskHandle_t logger_htask_;
+
+static logger_channel_t logger_channel_[LOGGER_CONFIG_CHANNELS];
+static uint32_t logger_channel_used_;
+
+static logger_site_t* logger_sites_;
+
+#if LOGGER_BACKEND_UART_DMA == LOGGER_CONFIG_BACKEND
+extern UART_HandleTypeDef huart3;
+
+/* DMA sends one half while the drain task fills the other */
+static char logger_uart_buffer_[2][LOGGER_CONFIG_UART_BUFFER];
+static uint8_t logger_uart_fill_;
+static size_t logger_uart_fill_len_;
+static bool logger_uart_busy_;
+static SemaphoreHandle_t logger_uart_done_;
+static StaticSemaphore_t logger_uart_done_buffer_;
+#endif
+
 /********************** external data definition *****************************/
 
-static char logger_msg_buffer_[LOGGER_CONFIG_MAXLEN];
-char* const logger_msg = logger_msg_buffer_;
-int logger_msg_len;
+#define LOGGER_LEVEL_INIT_(module, threshold)   [LOGGER_MODULE_ID_##module] = (threshold),
+uint8_t logger_level[LOGGER_MODULE__N] =
+{
+	LOGGER_MODULE_TABLE(LOGGER_LEVEL_INIT_)
+};
+#undef LOGGER_LEVEL_INIT_
 
 /********************** internal functions definition ************************/
 
+/* Sequence of the slot of pos as stored, pos minus the slot index */
+static inline uint32_t logger_seq_(uint32_t pos)
+{
+	return pos & ~(uint32_t)(LOGGER_CONFIG_SLOTS - 1);
+}
+
+static logger_slot_t* logger_reserve_(uint32_t* ppos)
+{
+	uint32_t pos = __atomic_load_n(&logger_head_, __ATOMIC_RELAXED);
+	while (true)
+	{
+		logger_slot_t* pslot = &logger_ring_[pos % LOGGER_CONFIG_SLOTS];
+		uint32_t seq = __atomic_load_n(&pslot->seq, __ATOMIC_ACQUIRE);
+		int32_t diff = (int32_t)(seq - logger_seq_(pos));
+		if (0 == diff)
+		{
+			if (__atomic_compare_exchange_n(&logger_head_, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				*ppos = pos;
+				return pslot;
+			}
+		}
+		else if (diff < 0)
+		{
+			/* The slot still holds last lap's message, the ring is full */
+			return NULL;
+		}
+		else
+		{
+			pos = __atomic_load_n(&logger_head_, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+/* The calling task's channel, claimed on its first log. NULL routes to the shared ring */
+static logger_channel_t* logger_channel_get_(void)
+{
+	if (xPortIsInsideInterrupt() || (taskSCHEDULER_RUNNING != xTaskGetSchedulerState()))
+	{
+		return NULL;
+	}
+
+	logger_channel_t* pchannel = pvTaskGetThreadLocalStoragePointer(NULL, LOGGER_CONFIG_TLS_INDEX);
+	if (NULL != pchannel)
+	{
+		return pchannel;
+	}
+
+	uint32_t used = __atomic_load_n(&logger_channel_used_, __ATOMIC_RELAXED);
+	uint32_t index;
+	do
+	{
+		uint32_t available = ~used & LOGGER_CHANNEL_ALL_;
+		if (0 == available)
+		{
+			return NULL;
+		}
+		index = (uint32_t)__builtin_ctz(available);
+	} while (!__atomic_compare_exchange_n(&logger_channel_used_, &used, used | (1UL << index), true,
+	                                      __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+	/* A free channel is always drained, head equals tail */
+	pchannel = &logger_channel_[index];
+	vTaskSetThreadLocalStoragePointer(NULL, LOGGER_CONFIG_TLS_INDEX, pchannel);
+	return pchannel;
+}
+
+static bool logger_begin_(logger_ticket_t* pticket)
+{
+	uint32_t timestamp = cycle_counter_get();
+
+	pticket->pchannel = logger_channel_get_();
+	if (NULL != pticket->pchannel)
+	{
+		logger_channel_t* pchannel = pticket->pchannel;
+		uint32_t head = pchannel->head;
+		if (LOGGER_CONFIG_CHANNEL_SLOTS <= (head - __atomic_load_n(&pchannel->tail, __ATOMIC_ACQUIRE)))
+		{
+			pticket->pslot = NULL;
+		}
+		else
+		{
+			pticket->pslot = &pchannel->slot[head % LOGGER_CONFIG_CHANNEL_SLOTS];
+		}
+	}
+	else
+	{
+		pticket->pslot = logger_reserve_(&pticket->pos);
+	}
+
+	if (NULL == pticket->pslot)
+	{
+		__atomic_fetch_add(&logger_dropped_, 1, __ATOMIC_RELAXED);
+		return false;
+	}
+	pticket->pslot->timestamp = timestamp;
+	return true;
+}
+
+static void logger_end_(logger_ticket_t* pticket)
+{
+	if (NULL != pticket->pchannel)
+	{
+		__atomic_store_n(&pticket->pchannel->head, pticket->pchannel->head + 1, __ATOMIC_RELEASE);
+	}
+	else
+	{
+		__atomic_store_n(&pticket->pslot->seq, logger_seq_(pticket->pos) + 1, __ATOMIC_RELEASE);
+	}
+
+	if (NULL == logger_htask_)
+	{
+		return;
+	}
+	if (xPortIsInsideInterrupt())
+	{
+		BaseType_t higher_priority_task_woken = pdFALSE;
+		vTaskNotifyGiveFromISR(logger_htask_, &higher_priority_task_woken);
+		portYIELD_FROM_ISR(higher_priority_task_woken);
+	}
+	else if (taskSCHEDULER_RUNNING == xTaskGetSchedulerState())
+	{
+		xTaskNotifyGive(logger_htask_);
+	}
+}
+
+static inline bool logger_older_(const logger_slot_t* pslot, const logger_slot_t* pbest)
+{
+	return (NULL == pbest) || ((int32_t)(pslot->timestamp - pbest->timestamp) < 0);
+}
+
+/*
+ * k-way merge: repeatedly writes the oldest pending record among the shared ring and every
+ * channel. Records are ordered by the time they were started, one started before but
+ * committed after a written record comes out late.
+ */
+static void logger_drain_(void (*print)(const char* buf, size_t len))
+{
+	while (true)
+	{
+		const logger_slot_t* pbest = NULL;
+		logger_channel_t* pbest_channel = NULL;
+
+		logger_slot_t* pshared = &logger_ring_[logger_tail_ % LOGGER_CONFIG_SLOTS];
+		if ((logger_seq_(logger_tail_) + 1) == __atomic_load_n(&pshared->seq, __ATOMIC_ACQUIRE))
+		{
+			pbest = pshared;
+		}
+
+		uint32_t used = __atomic_load_n(&logger_channel_used_, __ATOMIC_ACQUIRE);
+		while (0 != used)
+		{
+			uint32_t index = (uint32_t)__builtin_ctz(used);
+			used &= used - 1;
+
+			logger_channel_t* pchannel = &logger_channel_[index];
+			if (pchannel->tail != __atomic_load_n(&pchannel->head, __ATOMIC_ACQUIRE))
+			{
+				const logger_slot_t* pslot = &pchannel->slot[pchannel->tail % LOGGER_CONFIG_CHANNEL_SLOTS];
+				if (logger_older_(pslot, pbest))
+				{
+					pbest = pslot;
+					pbest_channel = pchannel;
+				}
+			}
+			else if (__atomic_load_n(&pchannel->orphan, __ATOMIC_ACQUIRE))
+			{
+				pchannel->orphan = false;
+				__atomic_fetch_and(&logger_channel_used_, ~(1UL << index), __ATOMIC_RELEASE);
+			}
+		}
+
+		if (NULL == pbest)
+		{
+			break;
+		}
+
+		print(pbest->msg, pbest->len);
+		if (NULL != pbest_channel)
+		{
+			__atomic_store_n(&pbest_channel->tail, pbest_channel->tail + 1, __ATOMIC_RELEASE);
+		}
+		else
+		{
+			__atomic_store_n(&pshared->seq, logger_seq_(logger_tail_) + LOGGER_CONFIG_SLOTS, __ATOMIC_RELEASE);
+			logger_tail_++;
+		}
+	}
+}
+
+/* Everything drained goes to the backend and to the crash log */
+static void logger_emit_(const char* buf, size_t len)
+{
+	logger_log_print_(buf, len);
+	crash_log_write(buf, len);
+}
+
+/* Reports and writes the history the previous run left when it crashed */
+static void logger_crash_dump_(void)
+{
+	const crash_log_header_t* pheader = crash_log_pending();
+	if (NULL == pheader)
+	{
+		return;
+	}
+
+	/* Written as text, tokenized its RAM strings would not decode */
+	char line[32 + (2 * CRASH_LOG_WHERE_LEN)];
+	size_t len = logger_format(line, sizeof(line), "[error] crash: reason %lu %s:%lu task %s\n",
+	                           (unsigned long)pheader->reason, pheader->where, (unsigned long)pheader->info,
+	                           pheader->task);
+	if (sizeof(line) <= len)
+	{
+		len = sizeof(line) - 1;
+		line[len - 1] = '\n';
+	}
+	logger_log_print_(line, len);
+	logger_drain_(logger_log_print_);
+	crash_log_dump(logger_log_print_);
+	LOGGER_ERROR("end of crash history");
+}
+
+static void logger_task_(void* argument)
+{
+	logger_crash_dump_();
+
+	uint32_t dropped_reported = 0;
+	uint32_t truncated_reported = 0;
+	while (true)
+	{
+		/* Also wakes up to report the counts of sites gone quiet */
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOGGER_CONFIG_SITE_REPEAT_MS));
+		logger_drain_(logger_emit_);
+		logger_site_sweep_();
+
+		uint32_t dropped = logger_dropped();
+		if (dropped != dropped_reported)
+		{
+			/* Goes through the ring so it is tokenized as well, it is drained on the next wake up */
+			LOGGER_WARN("%lu messages dropped", (unsigned long)(dropped - dropped_reported));
+			dropped_reported = dropped;
+		}
+
+		uint32_t truncated = logger_truncated();
+		if (truncated != truncated_reported)
+		{
+			LOGGER_WARN("%lu messages truncated", (unsigned long)(truncated - truncated_reported));
+			truncated_reported = truncated;
+		}
+	}
+}
+
+static inline void logger_put_u32_(char* p, uint32_t value)
+{
+	p[0] = (char)(value);
+	p[1] = (char)(value >> 8);
+	p[2] = (char)(value >> 16);
+	p[3] = (char)(value >> 24);
+}
+
+static uint32_t logger_hash_(uint32_t hash, const void* data, size_t len)
+{
+	const uint8_t* p = data;
+	while (0 < len--)
+	{
+		hash = (hash ^ *p++) * LOGGER_FNV_PRIME_;
+	}
+	return hash;
+}
+
+static inline uint32_t logger_now_ms_(void)
+{
+	TickType_t tick = xPortIsInsideInterrupt() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+	return (uint32_t)tick * portTICK_PERIOD_MS;
+}
+
+/* Reports name the site by its format, it ends the line. Tokenized, it is a .logstr string */
+static void logger_site_report_repeats_(logger_site_t* psite)
+{
+	uint16_t repeats = __atomic_exchange_n(&psite->repeats, 0, __ATOMIC_RELAXED);
+	if (0 < repeats)
+	{
+		LOGGER_LOG("[info] repeated %u times: %s", (unsigned int)repeats, psite->fmt);
+	}
+}
+
+static void logger_site_report_limited_(logger_site_t* psite)
+{
+	uint16_t limited = __atomic_exchange_n(&psite->limited, 0, __ATOMIC_RELAXED);
+	if (0 < limited)
+	{
+		LOGGER_LOG("[info] rate limited %u times: %s", (unsigned int)limited, psite->fmt);
+	}
+}
+
+/* Token bucket, one token per message, refilled one every LOGGER_CONFIG_SITE_PERIOD_MS */
+static bool logger_site_admit_(logger_site_t* psite, const char* fmt)
+{
+	uint32_t now = logger_now_ms_();
+	if (!__atomic_load_n(&psite->primed, __ATOMIC_RELAXED) &&
+	    !__atomic_exchange_n(&psite->primed, true, __ATOMIC_ACQ_REL))
+	{
+		/* Only the first use links the site, a preempting one linking it too would loop the list */
+		psite->fmt = fmt;
+		psite->tokens = LOGGER_CONFIG_SITE_BURST;
+		psite->refill_ms = now;
+
+		logger_site_t* phead = __atomic_load_n(&logger_sites_, __ATOMIC_RELAXED);
+		do
+		{
+			psite->pnext = phead;
+		} while (!__atomic_compare_exchange_n(&logger_sites_, &phead, psite, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+
+	uint32_t refill = (now - psite->refill_ms) / LOGGER_CONFIG_SITE_PERIOD_MS;
+	if (0 < refill)
+	{
+		uint32_t tokens = psite->tokens + refill;
+		psite->tokens = (uint8_t)((LOGGER_CONFIG_SITE_BURST < tokens) ? LOGGER_CONFIG_SITE_BURST : tokens);
+		psite->refill_ms += refill * LOGGER_CONFIG_SITE_PERIOD_MS;
+	}
+
+	if (0 == psite->tokens)
+	{
+		if (0 == __atomic_fetch_add(&psite->limited, 1, __ATOMIC_RELAXED))
+		{
+			psite->limited_ms = now;
+		}
+		return false;
+	}
+	psite->tokens--;
+
+	logger_site_report_limited_(psite);
+	return true;
+}
+
+/* true swallows a copy of the site's last message, counted and reported before the next one */
+static bool logger_site_repeated_(logger_site_t* psite, uint32_t hash)
+{
+	if (psite->hashed && (hash == psite->hash))
+	{
+		uint32_t now = logger_now_ms_();
+		uint16_t repeats = __atomic_add_fetch(&psite->repeats, 1, __ATOMIC_RELAXED);
+		if (1 == repeats)
+		{
+			psite->repeat_ms = now;
+		}
+		else if ((UINT16_MAX == repeats) || (LOGGER_CONFIG_SITE_REPEAT_MS <= (now - psite->repeat_ms)))
+		{
+			logger_site_report_repeats_(psite);
+		}
+		return true;
+	}
+	return false;
+}
+
+/* A new message made it past the bucket, it is the one repeats compare against now */
+static void logger_site_remember_(logger_site_t* psite, uint32_t hash)
+{
+	logger_site_report_repeats_(psite);
+	psite->hash = hash;
+	psite->hashed = true;
+}
+
+/* Repeats cost no token, only the messages written do */
+static bool logger_site_pass_(logger_site_t* psite, const char* fmt, uint32_t hash)
+{
+	if (logger_site_repeated_(psite, hash) || !logger_site_admit_(psite, fmt))
+	{
+		return false;
+	}
+	logger_site_remember_(psite, hash);
+	return true;
+}
+
+/* Reports the counts of sites quiet for LOGGER_CONFIG_SITE_REPEAT_MS, from the drain task */
+static void logger_site_sweep_(void)
+{
+	uint32_t now = logger_now_ms_();
+	for (logger_site_t* psite = __atomic_load_n(&logger_sites_, __ATOMIC_ACQUIRE); NULL != psite; psite = psite->pnext)
+	{
+		if ((0 < __atomic_load_n(&psite->repeats, __ATOMIC_RELAXED)) &&
+		    (LOGGER_CONFIG_SITE_REPEAT_MS <= (now - psite->repeat_ms)))
+		{
+			logger_site_report_repeats_(psite);
+		}
+		if ((0 < __atomic_load_n(&psite->limited, __ATOMIC_RELAXED)) &&
+		    (LOGGER_CONFIG_SITE_REPEAT_MS <= (now - psite->limited_ms)))
+		{
+			logger_site_report_limited_(psite);
+		}
+	}
+}
+
+/* Formatted on the stack first by logger_vformat(), so a repeat costs no slot and the report can go ahead of it */
+static void logger_vlog_(logger_site_t* psite, const char* fmt, va_list args)
+{
+	char msg[LOGGER_CONFIG_MAXLEN];
+	size_t len = logger_vformat(msg, sizeof(msg), fmt, args);
+	if (sizeof(msg) <= len)
+	{
+		/* Keeps the line break so the next message starts on its own line */
+		len = sizeof(msg) - 1;
+		msg[len - 1] = '\n';
+		__atomic_fetch_add(&logger_truncated_, 1, __ATOMIC_RELAXED);
+	}
+
+	if ((NULL != psite) && !logger_site_pass_(psite, fmt, logger_hash_(LOGGER_FNV_BASIS_, msg, len)))
+	{
+		return;
+	}
+
+	logger_ticket_t ticket;
+	if (!logger_begin_(&ticket))
+	{
+		return;
+	}
+	memcpy(ticket.pslot->msg, msg, len);
+	ticket.pslot->len = (uint16_t)len;
+	logger_end_(&ticket);
+}
+
+static void logger_vlog_token_(logger_site_t* psite, const char* fmt, uint32_t nargs, va_list args)
+{
+	if (LOGGER_TOKEN_MAX_ARGS < nargs)
+	{
+		nargs = LOGGER_TOKEN_MAX_ARGS;
+	}
+
+	uint32_t word[LOGGER_TOKEN_MAX_ARGS];
+	for (uint32_t i = 0; i < nargs; ++i)
+	{
+		word[i] = va_arg(args, uint32_t);
+	}
+
+	if (NULL != psite)
+	{
+		uint32_t hash = logger_hash_(LOGGER_FNV_BASIS_, &fmt, sizeof(fmt));
+		hash = logger_hash_(hash, word, nargs * sizeof(word[0]));
+		if (!logger_site_pass_(psite, fmt, hash))
+		{
+			return;
+		}
+	}
+
+	logger_ticket_t ticket;
+	if (!logger_begin_(&ticket))
+	{
+		return;
+	}
+	logger_slot_t* pslot = ticket.pslot;
+
+	char* p = pslot->msg;
+	p[0] = (char)LOGGER_TOKEN_SYNC;
+	p[1] = (char)nargs;
+	logger_put_u32_(&p[2], (uint32_t)(uintptr_t)fmt);
+	logger_put_u32_(&p[6], pslot->timestamp);
+	p += LOGGER_TOKEN_HEADER_LEN_;
+	for (uint32_t i = 0; i < nargs; ++i, p += 4)
+	{
+		logger_put_u32_(p, word[i]);
+	}
+	pslot->len = (uint16_t)(p - pslot->msg);
+
+	logger_end_(&ticket);
+}
+
+#if LOGGER_BACKEND_UART_DMA == LOGGER_CONFIG_BACKEND
+
+static void logger_backend_init_(void)
+{
+	logger_uart_done_ = xSemaphoreCreateBinaryStatic(&logger_uart_done_buffer_);
+	configASSERT(NULL != logger_uart_done_);
+
+	/* USART3 sits on APB1, oversampling by 16 tops out at PCLK1 / 16 */
+	HAL_UART_DeInit(&huart3);
+	huart3.Init.BaudRate = LOGGER_CONFIG_UART_BAUDRATE;
+	huart3.Init.OverSampling = ((HAL_RCC_GetPCLK1Freq() / 16) < LOGGER_CONFIG_UART_BAUDRATE) ? UART_OVERSAMPLING_8 : UART_OVERSAMPLING_16;
+	HAL_StatusTypeDef status = HAL_UART_Init(&huart3);
+	configASSERT(HAL_OK == status);
+	(void)status;
+}
+
+/* Starts sending the filled half if the DMA is idle, with interrupts masked or from the ISR */
+static void logger_uart_kick_(void)
+{
+	if (logger_uart_busy_ || (0 == logger_uart_fill_len_))
+	{
+		return;
+	}
+
+	uint8_t tx = logger_uart_fill_;
+	size_t len = logger_uart_fill_len_;
+	logger_uart_fill_ ^= 1;
+	logger_uart_fill_len_ = 0;
+	logger_uart_busy_ = true;
+	if (HAL_OK != HAL_UART_Transmit_DMA(&huart3, (uint8_t*)logger_uart_buffer_[tx], (uint16_t)len))
+	{
+		logger_uart_busy_ = false;
+	}
+}
+
+#else
+
+static void logger_backend_init_(void)
+{
+}
+
+#endif
+
 /********************** external functions definition ************************/
 
-#if 1 == LOGGER_CONFIG_USE_SEMIHOSTING
-void logger_log_print_(char* const msg)
+void logger_init(void)
+{
+	BaseType_t status;
+	crash_log_init();
+	logger_backend_init_();
+
+	status = app_task_create(APP_TASK_ID_LOGGER, logger_task_, NULL, &logger_htask_);
+	configASSERT(pdPASS == status);
+	/* Anything logged so far is drained on the first run */
+	xTaskNotifyGive(logger_htask_);
+}
+
+void logger_log(const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+	logger_vlog_(NULL, fmt, args);
+	va_end(args);
+}
+
+void logger_log_site(logger_site_t* psite, const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+	logger_vlog_(psite, fmt, args);
+	va_end(args);
+}
+
+void logger_log_token(const char* fmt, uint32_t nargs, ...)
+{
+	va_list args;
+	va_start(args, nargs);
+	logger_vlog_token_(NULL, fmt, nargs, args);
+	va_end(args);
+}
+
+void logger_log_token_site(logger_site_t* psite, const char* fmt, uint32_t nargs, ...)
+{
+	va_list args;
+	va_start(args, nargs);
+	logger_vlog_token_(psite, fmt, nargs, args);
+	va_end(args);
+}
+
+void logger_crash_flush(void)
+{
+	logger_drain_(crash_log_write);
+}
+
+void logger_task_deleted(void* htask)
+{
+	logger_channel_t* pchannel = pvTaskGetThreadLocalStoragePointer((TaskHandle_t)htask, LOGGER_CONFIG_TLS_INDEX);
+	if (NULL != pchannel)
+	{
+		__atomic_store_n(&pchannel->orphan, true, __ATOMIC_RELEASE);
+	}
+}
+
+void logger_level_set(logger_module_t module, uint8_t level)
 {
-	printf(msg);
+	if (module < LOGGER_MODULE__N)
+	{
+		__atomic_store_n(&logger_level[module], level, __ATOMIC_RELAXED);
+	}
+}
+
+uint32_t logger_dropped(void)
+{
+	return __atomic_load_n(&logger_dropped_, __ATOMIC_RELAXED);
+}
+
+uint32_t logger_truncated(void)
+{
+	return __atomic_load_n(&logger_truncated_, __ATOMIC_RELAXED);
+}
+
+#if LOGGER_BACKEND_SEMIHOSTING == LOGGER_CONFIG_BACKEND
+void logger_log_print_(const char* buf, size_t len)
+{
+	fwrite(buf, 1, len, stdout);
 	fflush(stdout);
 }
+#elif LOGGER_BACKEND_UART_DMA == LOGGER_CONFIG_BACKEND
+void logger_log_print_(const char* buf, size_t len)
+{
+	while (0 < len)
+	{
+		taskENTER_CRITICAL();
+		size_t n = LOGGER_CONFIG_UART_BUFFER - logger_uart_fill_len_;
+		if (len < n)
+		{
+			n = len;
+		}
+		memcpy(&logger_uart_buffer_[logger_uart_fill_][logger_uart_fill_len_], buf, n);
+		logger_uart_fill_len_ += n;
+		logger_uart_kick_();
+		taskEXIT_CRITICAL();
+
+		buf += n;
+		len -= n;
+		if (0 < len)
+		{
+			/* Both halves are taken, sleep until the DMA frees one */
+			xSemaphoreTake(logger_uart_done_, portMAX_DELAY);
+		}
+	}
+}
+
+static void logger_uart_tx_done_(UART_HandleTypeDef *huart)
+{
+	if (&huart3 != huart)
+	{
+		return;
+	}
+
+	BaseType_t higher_priority_task_woken = pdFALSE;
+	UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+	logger_uart_busy_ = false;
+	logger_uart_kick_();
+	taskEXIT_CRITICAL_FROM_ISR(mask);
+	xSemaphoreGiveFromISR(logger_uart_done_, &higher_priority_task_woken);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	logger_uart_tx_done_(huart);
+}
+
+/* A failed transfer loses its half, but must not leave the backend stuck busy */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	logger_uart_tx_done_(huart);
+}
 #else
-void logger_log_print_(char* const msg)
+void logger_log_print_(const char* buf, size_t len)
 {
     return;
 }
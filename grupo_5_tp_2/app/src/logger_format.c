@@ -0,0 +1,393 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : logger_format.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+#include "logger_format.h"
+
+/********************** macros and definitions *******************************/
+
+#define LOGGER_FORMAT_FLAG_LEFT_        (0x01)
+#define LOGGER_FORMAT_FLAG_ZERO_        (0x02)
+#define LOGGER_FORMAT_FLAG_UPPER_       (0x04)
+
+#define LOGGER_FORMAT_DIGITS_MAX_       (20)    /* Decimal digits of UINT64_MAX */
+
+/********************** internal data declaration ****************************/
+
+typedef struct
+{
+  char* buf;
+  size_t size;
+  size_t len;       /* Would be length, may exceed size */
+} logger_format_out_t;
+
+typedef enum
+{
+  LOGGER_FORMAT_LEN_CHAR_,
+  LOGGER_FORMAT_LEN_SHORT_,
+  LOGGER_FORMAT_LEN_INT_,
+  LOGGER_FORMAT_LEN_LONG_,
+  LOGGER_FORMAT_LEN_LLONG_,
+  LOGGER_FORMAT_LEN_SIZE_,
+} logger_format_len_t;
+
+typedef struct
+{
+  uint8_t flags;
+  int width;
+  int precision;    /* -1 when absent */
+} logger_format_spec_t;
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+static const char logger_format_lower_[] = "0123456789abcdef";
+static const char logger_format_upper_[] = "0123456789ABCDEF";
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+static inline void logger_format_putc_(logger_format_out_t* out, char c)
+{
+  if(out->len + 1 < out->size)
+  {
+    out->buf[out->len] = c;
+  }
+  out->len++;
+}
+
+static void logger_format_pad_(logger_format_out_t* out, char c, int n)
+{
+  while(0 < n--)
+  {
+    logger_format_putc_(out, c);
+  }
+}
+
+static void logger_format_puts_(logger_format_out_t* out, const char* s, size_t n)
+{
+  for(size_t i = 0; i < n; ++i)
+  {
+    logger_format_putc_(out, s[i]);
+  }
+}
+
+/* Digits in reverse order, a 32 bit loop for the common case, the 64 bit division only
+ * for values that need it */
+static int logger_format_digits_(char* digits, uint64_t value, unsigned int base, bool upper)
+{
+  const char* table = upper ? logger_format_upper_ : logger_format_lower_;
+  int n = 0;
+  while(UINT32_MAX < value)
+  {
+    digits[n++] = table[value % base];
+    value /= base;
+  }
+  uint32_t value32 = (uint32_t)value;
+  while(0 != value32)
+  {
+    digits[n++] = table[value32 % base];
+    value32 /= base;
+  }
+  return n;
+}
+
+static void logger_format_uint_(logger_format_out_t* out, const logger_format_spec_t* spec, uint64_t value,
+                                unsigned int base, const char* prefix)
+{
+  char digits[LOGGER_FORMAT_DIGITS_MAX_];
+  int ndigits = logger_format_digits_(digits, value, base, 0 != (spec->flags & LOGGER_FORMAT_FLAG_UPPER_));
+
+  /* Precision is the minimum number of digits, zero prints nothing for a zero value */
+  int nzeros = 0;
+  if(spec->precision < 0)
+  {
+    nzeros = (0 == ndigits) ? 1 : 0;
+  }
+  else if(ndigits < spec->precision)
+  {
+    nzeros = spec->precision - ndigits;
+  }
+
+  int nprefix = 0;
+  while('\0' != prefix[nprefix])
+  {
+    nprefix++;
+  }
+
+  int pad = spec->width - (nprefix + nzeros + ndigits);
+  if((0 < pad) && (0 == (spec->flags & LOGGER_FORMAT_FLAG_LEFT_)))
+  {
+    if((0 != (spec->flags & LOGGER_FORMAT_FLAG_ZERO_)) && (spec->precision < 0))
+    {
+      nzeros += pad;
+    }
+    else
+    {
+      logger_format_pad_(out, ' ', pad);
+    }
+    pad = 0;
+  }
+
+  logger_format_puts_(out, prefix, (size_t)nprefix);
+  logger_format_pad_(out, '0', nzeros);
+  while(0 < ndigits)
+  {
+    logger_format_putc_(out, digits[--ndigits]);
+  }
+  logger_format_pad_(out, ' ', pad);
+}
+
+static void logger_format_str_(logger_format_out_t* out, const logger_format_spec_t* spec, const char* s)
+{
+  if(NULL == s)
+  {
+    s = "(null)";
+  }
+  size_t n = 0;
+  while(((spec->precision < 0) || (n < (size_t)spec->precision)) && ('\0' != s[n]))
+  {
+    n++;
+  }
+
+  int pad = spec->width - (int)n;
+  if(0 == (spec->flags & LOGGER_FORMAT_FLAG_LEFT_))
+  {
+    logger_format_pad_(out, ' ', pad);
+  }
+  logger_format_puts_(out, s, n);
+  if(0 != (spec->flags & LOGGER_FORMAT_FLAG_LEFT_))
+  {
+    logger_format_pad_(out, ' ', pad);
+  }
+}
+
+static int logger_format_number_(const char** pfmt)
+{
+  int n = 0;
+  while(('0' <= **pfmt) && (**pfmt <= '9'))
+  {
+    n = 10 * n + (*(*pfmt)++ - '0');
+  }
+  return n;
+}
+
+/********************** external functions definition ************************/
+
+size_t logger_vformat(char* buf, size_t size, const char* fmt, va_list args)
+{
+  logger_format_out_t out = {.buf = buf, .size = size, .len = 0};
+
+  while('\0' != *fmt)
+  {
+    if('%' != *fmt)
+    {
+      logger_format_putc_(&out, *fmt++);
+      continue;
+    }
+    const char* conversion = fmt++;
+
+    logger_format_spec_t spec = {.flags = 0, .width = 0, .precision = -1};
+    for(;; ++fmt)
+    {
+      if('-' == *fmt)
+      {
+        spec.flags |= LOGGER_FORMAT_FLAG_LEFT_;
+      }
+      else if('0' == *fmt)
+      {
+        spec.flags |= LOGGER_FORMAT_FLAG_ZERO_;
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    if('*' == *fmt)
+    {
+      fmt++;
+      spec.width = va_arg(args, int);
+      if(spec.width < 0)
+      {
+        spec.flags |= LOGGER_FORMAT_FLAG_LEFT_;
+        spec.width = -spec.width;
+      }
+    }
+    else
+    {
+      spec.width = logger_format_number_(&fmt);
+    }
+
+    if('.' == *fmt)
+    {
+      fmt++;
+      if('*' == *fmt)
+      {
+        fmt++;
+        spec.precision = va_arg(args, int);
+      }
+      else
+      {
+        spec.precision = logger_format_number_(&fmt);
+      }
+    }
+
+    logger_format_len_t len = LOGGER_FORMAT_LEN_INT_;
+    if('h' == *fmt)
+    {
+      fmt++;
+      len = LOGGER_FORMAT_LEN_SHORT_;
+      if('h' == *fmt)
+      {
+        fmt++;
+        len = LOGGER_FORMAT_LEN_CHAR_;
+      }
+    }
+    else if('l' == *fmt)
+    {
+      fmt++;
+      len = LOGGER_FORMAT_LEN_LONG_;
+      if('l' == *fmt)
+      {
+        fmt++;
+        len = LOGGER_FORMAT_LEN_LLONG_;
+      }
+    }
+    else if('z' == *fmt)
+    {
+      fmt++;
+      len = LOGGER_FORMAT_LEN_SIZE_;
+    }
+
+    switch(*fmt)
+    {
+      case 'd':
+      case 'i':
+      {
+        int64_t value;
+        switch(len)
+        {
+          case LOGGER_FORMAT_LEN_CHAR_:  value = (signed char)va_arg(args, int); break;
+          case LOGGER_FORMAT_LEN_SHORT_: value = (short)va_arg(args, int); break;
+          case LOGGER_FORMAT_LEN_LONG_:  value = va_arg(args, long); break;
+          case LOGGER_FORMAT_LEN_LLONG_: value = va_arg(args, long long); break;
+          case LOGGER_FORMAT_LEN_SIZE_:  value = (ptrdiff_t)va_arg(args, size_t); break;
+          default:                       value = va_arg(args, int); break;
+        }
+        uint64_t magnitude = (value < 0) ? (0 - (uint64_t)value) : (uint64_t)value;
+        logger_format_uint_(&out, &spec, magnitude, 10, (value < 0) ? "-" : "");
+        break;
+      }
+
+      case 'u':
+      case 'x':
+      case 'X':
+      {
+        uint64_t value;
+        switch(len)
+        {
+          case LOGGER_FORMAT_LEN_CHAR_:  value = (unsigned char)va_arg(args, unsigned int); break;
+          case LOGGER_FORMAT_LEN_SHORT_: value = (unsigned short)va_arg(args, unsigned int); break;
+          case LOGGER_FORMAT_LEN_LONG_:  value = va_arg(args, unsigned long); break;
+          case LOGGER_FORMAT_LEN_LLONG_: value = va_arg(args, unsigned long long); break;
+          case LOGGER_FORMAT_LEN_SIZE_:  value = va_arg(args, size_t); break;
+          default:                       value = va_arg(args, unsigned int); break;
+        }
+        if('X' == *fmt)
+        {
+          spec.flags |= LOGGER_FORMAT_FLAG_UPPER_;
+        }
+        logger_format_uint_(&out, &spec, value, ('u' == *fmt) ? 10 : 16, "");
+        break;
+      }
+
+      case 'p':
+        logger_format_uint_(&out, &spec, (uintptr_t)va_arg(args, void*), 16, "0x");
+        break;
+
+      case 'c':
+      {
+        char c = (char)va_arg(args, int);
+        spec.precision = 1;
+        logger_format_str_(&out, &spec, &c);
+        break;
+      }
+
+      case 's':
+        logger_format_str_(&out, &spec, va_arg(args, const char*));
+        break;
+
+      case '%':
+        logger_format_putc_(&out, '%');
+        break;
+
+      default:
+        /* Unsupported, written as is so the message still shows what was meant */
+        if('\0' == *fmt)
+        {
+          fmt--;
+        }
+        logger_format_puts_(&out, conversion, (size_t)(fmt + 1 - conversion));
+        break;
+    }
+    fmt++;
+  }
+
+  if(0 < size)
+  {
+    buf[(out.len < size) ? out.len : (size - 1)] = '\0';
+  }
+  return out.len;
+}
+
+size_t logger_format(char* buf, size_t size, const char* fmt, ...)
+{
+  va_list args;
+  va_start(args, fmt);
+  size_t len = logger_vformat(buf, size, fmt, args);
+  va_end(args);
+  return len;
+}
+
+/********************** end of file ******************************************/
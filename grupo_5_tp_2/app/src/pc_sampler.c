@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : pc_sampler.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "pc_sampler.h"
+
+#if (1 == PC_SAMPLER_CONFIG_ENABLE)
+
+/********************** macros and definitions *******************************/
+
+#if 0 != (PC_SAMPLER_CONFIG_ENTRIES & (PC_SAMPLER_CONFIG_ENTRIES - 1))
+#error "PC_SAMPLER_CONFIG_ENTRIES must be a power of two"
+#endif
+
+#define PC_SAMPLER_EXC_RETURN_THREAD_   (0x08)  /* Returns to thread mode */
+#define PC_SAMPLER_EXC_RETURN_PSP_      (0x04)  /* Frame on the process stack */
+#define PC_SAMPLER_FRAME_PC_            (6)     /* r0-r3, r12, lr, pc, xpsr */
+#define PC_SAMPLER_PROBES_              (8)     /* Linear probing limit */
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+extern TIM_HandleTypeDef htim2;
+
+/* Task number each name slot was copied for */
+static uint16_t pc_sampler_name_task_[PC_SAMPLER_CONFIG_NAMES];
+
+/********************** external data definition *****************************/
+
+pc_sampler_t pc_sampler =
+{
+  .magic = PC_SAMPLER_MAGIC,
+  .version = PC_SAMPLER_VERSION,
+  .entry_size = sizeof(pc_sampler_entry_t),
+  .capacity = PC_SAMPLER_CONFIG_ENTRIES,
+  .names = PC_SAMPLER_CONFIG_NAMES,
+  .name_len = PC_SAMPLER_NAME_LEN,
+};
+
+/********************** internal functions definition ************************/
+
+static inline uint32_t pc_sampler_hash_(uint32_t pc, uint32_t task)
+{
+  /* Thumb code is halfword aligned, bit 0 carries nothing */
+  return ((pc >> 1) ^ (task * 0x9E3779B1UL)) * 0x85EBCA6BUL;
+}
+
+static void pc_sampler_add_(uint32_t pc, uint16_t task)
+{
+  uint32_t index = pc_sampler_hash_(pc, task) >> (32 - __builtin_ctz(PC_SAMPLER_CONFIG_ENTRIES));
+  for(uint32_t i = 0; i < PC_SAMPLER_PROBES_; ++i)
+  {
+    pc_sampler_entry_t* pentry = &pc_sampler.entry[(index + i) % PC_SAMPLER_CONFIG_ENTRIES];
+    if(0 == pentry->pc)
+    {
+      pentry->pc = pc;
+      pentry->task = task;
+    }
+    if((pc == pentry->pc) && (task == pentry->task))
+    {
+      pentry->count++;
+      return;
+    }
+  }
+  pc_sampler.dropped++;
+}
+
+/********************** external functions definition ************************/
+
+void pc_sampler_init(void)
+{
+  /* APB1 timers run at twice PCLK1 whenever APB1 is divided */
+  uint32_t clock = HAL_RCC_GetPCLK1Freq();
+  if(RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1))
+  {
+    clock *= 2;
+  }
+
+  pc_sampler.rate_hz = clock / ((htim2.Instance->PSC + 1) * (__HAL_TIM_GET_AUTORELOAD(&htim2) + 1));
+
+  /* Masked by the kernel's critical sections otherwise, CubeMX only allows it with
+   * "Uses FreeRTOS functions" off for TIM2 */
+  configASSERT(NVIC_GetPriority(TIM2_IRQn) < configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+
+  HAL_StatusTypeDef status = HAL_TIM_Base_Start_IT(&htim2);
+  configASSERT(HAL_OK == status);
+  (void)status;
+}
+
+/*
+ * Runs above the kernel's interrupt mask, so it only reads: pxCurrentTCB is stable in
+ * thread mode, the switch happens in PendSV, which counts as handler mode here.
+ */
+void pc_sampler_sample(uint32_t exc_return)
+{
+  pc_sampler.samples++;
+
+  if(0 == (exc_return & PC_SAMPLER_EXC_RETURN_THREAD_))
+  {
+    pc_sampler.handler++;
+    return;
+  }
+  if(0 == (exc_return & PC_SAMPLER_EXC_RETURN_PSP_))
+  {
+    pc_sampler.startup++;
+    return;
+  }
+
+  const uint32_t* frame = (const uint32_t*)__get_PSP();
+  TaskHandle_t htask = xTaskGetCurrentTaskHandle();
+  /* Numbered from 1 by the traceTASK_CREATE hook, kernel_trace.c */
+  uint16_t task = (uint16_t)uxTaskGetTaskNumber(htask);
+
+  uint32_t slot = task % PC_SAMPLER_CONFIG_NAMES;
+  if(task != pc_sampler_name_task_[slot])
+  {
+    pc_sampler_name_task_[slot] = task;
+    strncpy(pc_sampler.name[slot], pcTaskGetName(htask), PC_SAMPLER_NAME_LEN - 1);
+  }
+
+  pc_sampler_add_(frame[PC_SAMPLER_FRAME_PC_], task);
+}
+
+void pc_sampler_reset(void)
+{
+  HAL_NVIC_DisableIRQ(TIM2_IRQn);
+  memset(pc_sampler.entry, 0, sizeof(pc_sampler.entry));
+  pc_sampler.samples = 0;
+  pc_sampler.handler = 0;
+  pc_sampler.startup = 0;
+  pc_sampler.dropped = 0;
+  HAL_NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+#endif
+
+/********************** end of file ******************************************/
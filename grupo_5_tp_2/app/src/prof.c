@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : prof.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#define LOGGER_MODULE   PROF    /* Before logger.h */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+#include "prof.h"
+
+#if (1 == PROF_CONFIG_ENABLE)
+
+/********************** macros and definitions *******************************/
+
+#define PROF_CALIBRATION_RUNS_          (16)
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+static prof_stats_t prof_stats_[PROF_ID__N];
+static uint32_t prof_overhead_;
+
+#if (1 == configGENERATE_RUN_TIME_STATS)
+static TaskStatus_t prof_cpu_status_[PROF_CONFIG_CPU_TASKS];
+static struct
+{
+  UBaseType_t number;
+  uint32_t counter;
+} prof_cpu_last_[PROF_CONFIG_CPU_TASKS];
+static UBaseType_t prof_cpu_last_n_;
+static uint32_t prof_cpu_last_total_;
+#endif
+
+#define PROF_NAME_(probe, name)         [PROF_ID_##probe] = (name),
+static const char* const prof_name_[PROF_ID__N] =
+{
+  PROF_PROBE_TABLE(PROF_NAME_)
+};
+#undef PROF_NAME_
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+static uint32_t prof_bucket_(uint32_t cycles)
+{
+  uint32_t b = (0 == cycles) ? 0 : (32 - (uint32_t)__builtin_clz(cycles));
+  return (b < PROF_CONFIG_BUCKETS) ? b : (PROF_CONFIG_BUCKETS - 1);
+}
+
+/* Upper bound, in cycles, of the bucket holding the given percentile */
+static uint32_t prof_percentile_(const prof_stats_t* pstats, uint32_t percent)
+{
+  uint32_t rank = ((pstats->count * percent) + 99) / 100;
+  uint32_t acc = 0;
+  for(uint32_t b = 0; b < PROF_CONFIG_BUCKETS; ++b)
+  {
+    acc += pstats->bucket[b];
+    if(rank <= acc)
+    {
+      return (0 == b) ? 0 : (uint32_t)((1ULL << b) - 1);
+    }
+  }
+  return pstats->max;
+}
+
+/********************** external functions definition ************************/
+
+void prof_init(void)
+{
+  /* An empty probe, the smallest of a few runs is what every sample pays on top */
+  prof_overhead_ = UINT32_MAX;
+  for(uint32_t i = 0; i < PROF_CALIBRATION_RUNS_; ++i)
+  {
+    uint32_t start = cycle_counter_get();
+    uint32_t cycles = cycle_counter_get() - start;
+    if(cycles < prof_overhead_)
+    {
+      prof_overhead_ = cycles;
+    }
+  }
+}
+
+void prof_record(prof_id_t id, uint32_t cycles)
+{
+  if(PROF_ID__N <= id)
+  {
+    return;
+  }
+  cycles = (prof_overhead_ < cycles) ? (cycles - prof_overhead_) : 0;
+
+  UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+  prof_stats_t* pstats = &prof_stats_[id];
+  if((0 == pstats->count) || (cycles < pstats->min))
+  {
+    pstats->min = cycles;
+  }
+  if(pstats->max < cycles)
+  {
+    pstats->max = cycles;
+  }
+  pstats->sum += cycles;
+  pstats->count++;
+  pstats->bucket[prof_bucket_(cycles)]++;
+  taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+void prof_stats_get(prof_id_t id, prof_stats_t* pstats)
+{
+  if(PROF_ID__N <= id)
+  {
+    return;
+  }
+  taskENTER_CRITICAL();
+  *pstats = prof_stats_[id];
+  taskEXIT_CRITICAL();
+}
+
+void prof_report(void)
+{
+  for(uint32_t id = 0; id < PROF_ID__N; ++id)
+  {
+    prof_stats_t stats;
+    prof_stats_get((prof_id_t)id, &stats);
+    if(0 == stats.count)
+    {
+      continue;
+    }
+    LOGGER_REPORT("prof %s: n=%lu min=%lu avg=%lu max=%lu cyc", prof_name_[id], (unsigned long)stats.count,
+                  (unsigned long)stats.min, (unsigned long)(stats.sum / stats.count), (unsigned long)stats.max);
+    LOGGER_REPORT("prof %s: p50<=%lu p90<=%lu p99<=%lu cyc", prof_name_[id],
+                  (unsigned long)prof_percentile_(&stats, 50), (unsigned long)prof_percentile_(&stats, 90),
+                  (unsigned long)prof_percentile_(&stats, 99));
+  }
+}
+
+void prof_cpu_report(void)
+{
+#if (1 == configGENERATE_RUN_TIME_STATS)
+  uint32_t total;
+  UBaseType_t n = uxTaskGetSystemState(prof_cpu_status_, PROF_CONFIG_CPU_TASKS, &total);
+  if(0 == n)
+  {
+    LOGGER_WARN("cpu: more than %u tasks", (unsigned int)PROF_CONFIG_CPU_TASKS);
+    return;
+  }
+
+  /* Unsigned differences stay right across a wrap of the run time counter */
+  uint32_t elapsed = total - prof_cpu_last_total_;
+  if(0 == elapsed)
+  {
+    return;
+  }
+
+  for(UBaseType_t i = 0; i < n; ++i)
+  {
+    const TaskStatus_t* pstatus = &prof_cpu_status_[i];
+    uint32_t last = 0;
+    for(UBaseType_t j = 0; j < prof_cpu_last_n_; ++j)
+    {
+      if(pstatus->xTaskNumber == prof_cpu_last_[j].number)
+      {
+        last = prof_cpu_last_[j].counter;
+        break;
+      }
+    }
+    uint32_t permille = (uint32_t)(((uint64_t)(pstatus->ulRunTimeCounter - last) * 1000) / elapsed);
+    LOGGER_REPORT("cpu %s: %lu.%lu%%", pstatus->pcTaskName, (unsigned long)(permille / 10), (unsigned long)(permille % 10));
+  }
+
+  for(UBaseType_t i = 0; i < n; ++i)
+  {
+    prof_cpu_last_[i].number = prof_cpu_status_[i].xTaskNumber;
+    prof_cpu_last_[i].counter = prof_cpu_status_[i].ulRunTimeCounter;
+  }
+  prof_cpu_last_n_ = n;
+  prof_cpu_last_total_ = total;
+#endif
+}
+
+void prof_reset(void)
+{
+  taskENTER_CRITICAL();
+  for(uint32_t id = 0; id < PROF_ID__N; ++id)
+  {
+    prof_stats_[id] = (prof_stats_t){0};
+  }
+  taskEXIT_CRITICAL();
+}
+
+#endif
+
+/********************** end of file ******************************************/
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : prof_critical.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#define LOGGER_MODULE   PROF    /* Before logger.h */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "dwt.h"
+#include "prof_critical.h"
+
+/********************** macros and definitions *******************************/
+
+#if (1 == PROF_CRITICAL_CONFIG_ENABLE) && (1 != INCLUDE_xTaskGetSchedulerState)
+#error "The critical section profiler waits for the scheduler through INCLUDE_xTaskGetSchedulerState"
+#endif
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+
+void __real_vPortEnterCritical(void);
+void __real_vPortExitCritical(void);
+void __wrap_vPortEnterCritical(void);
+void __wrap_vPortExitCritical(void);
+
+/********************** internal data definition *****************************/
+
+#if (1 == PROF_CRITICAL_CONFIG_ENABLE)
+/* Only touched with interrupts masked */
+static prof_critical_stats_t prof_critical_;
+static uint32_t prof_critical_start_;
+static uint32_t prof_critical_site_;
+#endif
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+#if (1 == PROF_CRITICAL_CONFIG_ENABLE)
+/* Still masked, after the section was timed: its cost is not in the figures */
+static void prof_critical_record_(uint32_t site, uint32_t cycles)
+{
+  prof_critical_.count++;
+  prof_critical_.sum += cycles;
+  if(prof_critical_.max < cycles)
+  {
+    prof_critical_.max = cycles;
+  }
+
+  /* The site itself or else the shortest of the kept ones, free slots first */
+  prof_critical_site_t* pmin = &prof_critical_.top[0];
+  for(uint32_t i = 0; i < PROF_CRITICAL_CONFIG_TOP; ++i)
+  {
+    prof_critical_site_t* psite = &prof_critical_.top[i];
+    if(site == psite->site)
+    {
+      psite->count++;
+      if(psite->max < cycles)
+      {
+        psite->max = cycles;
+      }
+      return;
+    }
+    if((0 != pmin->count) && ((0 == psite->count) || (psite->max < pmin->max)))
+    {
+      pmin = psite;
+    }
+  }
+  if((0 == pmin->count) || (pmin->max < cycles))
+  {
+    pmin->site = site;
+    pmin->count = 1;
+    pmin->max = cycles;
+  }
+}
+#endif
+
+/********************** external functions definition ************************/
+
+void __wrap_vPortEnterCritical(void)
+{
+  __real_vPortEnterCritical();
+#if (1 == PROF_CRITICAL_CONFIG_ENABLE)
+  /* Before the scheduler runs the port leaves interrupts masked on exit, nothing ends */
+  if(taskSCHEDULER_NOT_STARTED == xTaskGetSchedulerState())
+  {
+    return;
+  }
+  if(1 == ++prof_critical_.depth)
+  {
+    prof_critical_site_ = (uint32_t)__builtin_return_address(0) & ~1UL;
+    prof_critical_start_ = cycle_counter_get();
+  }
+  if(prof_critical_.depth_max < prof_critical_.depth)
+  {
+    prof_critical_.depth_max = prof_critical_.depth;
+  }
+#endif
+}
+
+void __wrap_vPortExitCritical(void)
+{
+#if (1 == PROF_CRITICAL_CONFIG_ENABLE)
+  /* Unbalanced exits are the kernel's to assert on, and none counted before the scheduler */
+  if(0 < prof_critical_.depth)
+  {
+    if(1 == prof_critical_.depth)
+    {
+      prof_critical_record_(prof_critical_site_, cycle_counter_get() - prof_critical_start_);
+    }
+    prof_critical_.depth--;
+  }
+#endif
+  __real_vPortExitCritical();
+}
+
+#if (1 == PROF_CRITICAL_CONFIG_ENABLE)
+
+void prof_critical_stats_get(prof_critical_stats_t* pstats)
+{
+  /* The copy is a section of its own, it shows up in the figures */
+  taskENTER_CRITICAL();
+  *pstats = prof_critical_;
+  taskEXIT_CRITICAL();
+}
+
+void prof_critical_report(void)
+{
+  prof_critical_stats_t stats;
+  prof_critical_stats_get(&stats);
+  if(0 == stats.count)
+  {
+    return;
+  }
+  LOGGER_INFO("crit: n=%lu avg=%lu max=%lu cyc depth<=%lu", (unsigned long)stats.count,
+              (unsigned long)(stats.sum / stats.count), (unsigned long)stats.max, (unsigned long)stats.depth_max);
+
+  /* Longest first, selection over a handful of entries */
+  bool shown[PROF_CRITICAL_CONFIG_TOP] = {false};
+  for(uint32_t n = 0; n < PROF_CRITICAL_CONFIG_TOP; ++n)
+  {
+    int longest = -1;
+    for(uint32_t i = 0; i < PROF_CRITICAL_CONFIG_TOP; ++i)
+    {
+      if(!shown[i] && (0 != stats.top[i].count) && ((longest < 0) || (stats.top[longest].max < stats.top[i].max)))
+      {
+        longest = (int)i;
+      }
+    }
+    if(longest < 0)
+    {
+      break;
+    }
+    shown[longest] = true;
+    LOGGER_REPORT("crit 0x%08lx: n=%lu max=%lu cyc", (unsigned long)stats.top[longest].site,
+                  (unsigned long)stats.top[longest].count, (unsigned long)stats.top[longest].max);
+  }
+}
+
+void prof_critical_reset(void)
+{
+  taskENTER_CRITICAL();
+  /* Keep the nesting of the section we are in */
+  uint32_t depth = prof_critical_.depth;
+  prof_critical_ = (prof_critical_stats_t){0};
+  prof_critical_.depth = depth;
+  prof_critical_.depth_max = depth;
+  taskEXIT_CRITICAL();
+}
+
+#endif
+
+/********************** end of file ******************************************/
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : stack_mon.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/********************** inclusions *******************************************/
+
+#define LOGGER_MODULE   STACK   /* Before logger.h */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+#include "cmsis_os.h"
+#include "logger.h"
+#include "app.h"
+#include "prof_critical.h"
+#include "latency_trace.h"
+#include "stack_mon.h"
+
+#if (1 == STACK_MON_CONFIG_ENABLE)
+
+/********************** macros and definitions *******************************/
+
+#define STACK_MON_DEFAULT_TASK_WORDS_   (128)   /* osThreadDef(defaultTask, ...) in main.c */
+#define STACK_MON_PROF_EVERY_           (PROF_CONFIG_REPORT_MS / STACK_MON_CONFIG_PERIOD_MS)
+#define STACK_MON_LATENCY_EVERY_        (LATENCY_TRACE_CONFIG_REPORT_MS / STACK_MON_CONFIG_PERIOD_MS)
+
+/********************** internal data declaration ****************************/
+
+typedef struct
+{
+  char name[configMAX_TASK_NAME_LEN];
+  uint32_t stack_words;
+  uint32_t free_words;
+  uint32_t reported_words;          /* free_words at the last report, UINT32_MAX before it */
+} stack_mon_task_t;
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+
+/* Tasks the table does not describe */
+static const struct
+{
+  const char* name;
+  uint32_t stack_words;
+} stack_mon_extra_[] =
+{
+  { "IDLE", configMINIMAL_STACK_SIZE },
+  { "defaultTask", STACK_MON_DEFAULT_TASK_WORDS_ },
+};
+
+static TaskStatus_t stack_mon_status_[STACK_MON_CONFIG_TASKS];
+static stack_mon_task_t stack_mon_task_[STACK_MON_CONFIG_TASKS];
+static uint32_t stack_mon_ntasks_;
+
+/********************** external data definition *****************************/
+
+/********************** internal functions definition ************************/
+
+/* Size of a task's stack from its name, 0 when unknown (LED workers take the LED's name) */
+static uint32_t stack_mon_size_(const char* name)
+{
+  for(uint32_t i = 0; i < APP_TASK__N; ++i)
+  {
+    if(0 == strcmp(name, app_task_config[i].name))
+    {
+      return app_task_config[i].stack_words;
+    }
+  }
+  for(uint32_t i = 0; i < (sizeof(stack_mon_extra_) / sizeof(stack_mon_extra_[0])); ++i)
+  {
+    if(0 == strcmp(name, stack_mon_extra_[i].name))
+    {
+      return stack_mon_extra_[i].stack_words;
+    }
+  }
+  return 0;
+}
+
+static uint32_t stack_mon_recommend_(uint32_t stack_words, uint32_t free_words)
+{
+  if(0 == stack_words)
+  {
+    return 0;
+  }
+  uint32_t used = (free_words < stack_words) ? (stack_words - free_words) : 0;
+  uint32_t margin = (used * STACK_MON_CONFIG_MARGIN_PCT) / 100;
+  if(margin < STACK_MON_CONFIG_MARGIN_WORDS)
+  {
+    margin = STACK_MON_CONFIG_MARGIN_WORDS;
+  }
+  uint32_t words = used + margin;
+  return ((words + STACK_MON_CONFIG_ROUND_WORDS - 1) / STACK_MON_CONFIG_ROUND_WORDS) * STACK_MON_CONFIG_ROUND_WORDS;
+}
+
+static stack_mon_task_t* stack_mon_find_(const char* name)
+{
+  for(uint32_t i = 0; i < stack_mon_ntasks_; ++i)
+  {
+    if(0 == strcmp(name, stack_mon_task_[i].name))
+    {
+      return &stack_mon_task_[i];
+    }
+  }
+  if(STACK_MON_CONFIG_TASKS <= stack_mon_ntasks_)
+  {
+    return NULL;
+  }
+  stack_mon_task_t* ptask = &stack_mon_task_[stack_mon_ntasks_];
+  strncpy(ptask->name, name, sizeof(ptask->name) - 1);
+  ptask->stack_words = stack_mon_size_(name);
+  ptask->free_words = UINT32_MAX;
+  ptask->reported_words = UINT32_MAX;
+  stack_mon_ntasks_++;
+  return ptask;
+}
+
+static void stack_mon_sample_(void)
+{
+  UBaseType_t n = uxTaskGetSystemState(stack_mon_status_, STACK_MON_CONFIG_TASKS, NULL);
+  if(0 == n)
+  {
+    LOGGER_WARN("more than %u tasks", (unsigned int)STACK_MON_CONFIG_TASKS);
+    return;
+  }
+
+  for(UBaseType_t i = 0; i < n; ++i)
+  {
+    stack_mon_task_t* ptask = stack_mon_find_(stack_mon_status_[i].pcTaskName);
+    if((NULL != ptask) && (stack_mon_status_[i].usStackHighWaterMark < ptask->free_words))
+    {
+      ptask->free_words = stack_mon_status_[i].usStackHighWaterMark;
+    }
+  }
+}
+
+/* One line per task whose headroom shrank since the last report */
+static void stack_mon_report_(void)
+{
+  for(uint32_t i = 0; i < stack_mon_ntasks_; ++i)
+  {
+    stack_mon_task_t* ptask = &stack_mon_task_[i];
+    if(ptask->free_words == ptask->reported_words)
+    {
+      continue;
+    }
+    ptask->reported_words = ptask->free_words;
+
+    uint32_t recommended = stack_mon_recommend_(ptask->stack_words, ptask->free_words);
+    if(0 == recommended)
+    {
+      LOGGER_REPORT("%s: %lu words free", ptask->name, (unsigned long)ptask->free_words);
+    }
+    else if(ptask->stack_words < recommended)
+    {
+      LOGGER_WARN("%s: %lu of %lu words free, raise it to %lu", ptask->name, (unsigned long)ptask->free_words,
+                  (unsigned long)ptask->stack_words, (unsigned long)recommended);
+    }
+    else
+    {
+      LOGGER_REPORT("%s: %lu of %lu words free, %lu would do", ptask->name, (unsigned long)ptask->free_words,
+                    (unsigned long)ptask->stack_words, (unsigned long)recommended);
+    }
+  }
+}
+
+/*
+ * The profiling and latency reports format dozens of lines, they run here at the bottom of the
+ * priorities rather than in the timer service task, which the LED and button timers share
+ */
+static void stack_mon_prof_report_(void)
+{
+#if (0 < STACK_MON_PROF_EVERY_)
+  static uint32_t periods;
+  if(0 != (++periods % STACK_MON_PROF_EVERY_))
+  {
+    return;
+  }
+  prof_report();
+  prof_cpu_report();
+  prof_critical_report();
+#endif
+}
+
+static void stack_mon_latency_report_(void)
+{
+#if (0 < STACK_MON_LATENCY_EVERY_)
+  static uint32_t periods;
+  if(0 != (++periods % STACK_MON_LATENCY_EVERY_))
+  {
+    return;
+  }
+  latency_trace_report();
+#endif
+}
+
+static void stack_mon_task_run_(void* argument)
+{
+  TickType_t wake = xTaskGetTickCount();
+  while(true)
+  {
+    stack_mon_sample_();
+    stack_mon_report_();
+    stack_mon_prof_report_();
+    stack_mon_latency_report_();
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(STACK_MON_CONFIG_PERIOD_MS));
+  }
+}
+
+/********************** external functions definition ************************/
+
+void stack_mon_init(void)
+{
+  BaseType_t status = app_task_create(APP_TASK_ID_STACK_MON, stack_mon_task_run_, NULL, NULL);
+  configASSERT(pdPASS == status);
+  (void)status;
+}
+
+bool stack_mon_get(uint32_t entry, stack_mon_entry_t* pentry)
+{
+  /* Entries are only appended, and filled in before the count grows */
+  if(stack_mon_ntasks_ <= entry)
+  {
+    return false;
+  }
+  const stack_mon_task_t* ptask = &stack_mon_task_[entry];
+  pentry->name = ptask->name;
+  pentry->stack_words = ptask->stack_words;
+  pentry->free_words = ptask->free_words;
+  pentry->recommended_words = stack_mon_recommend_(ptask->stack_words, ptask->free_words);
+  return true;
+}
+
+#endif
+
+/********************** end of file ******************************************/
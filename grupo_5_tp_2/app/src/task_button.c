@@ -34,6 +34,8 @@
 
 /********************** inclusions *******************************************/
 
+#define LOGGER_MODULE   BUTTON    /* Before logger.h */
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -46,6 +48,9 @@
 #include "task_led.h"
 #include "app.h"
 #include "active_object_ui.h"
+#include "event_bus.h"
+#include "latency_trace.h"
+#include "button_scan.h"
 /********************** macros and definitions *******************************/
 
 #define TASK_PERIOD_MS_           (50)
@@ -61,12 +66,246 @@
 
 /********************** internal data definition *****************************/
 
-/********************** external data definition *****************************/
+#if (BUTTON_MODE_EXTI == BUTTON_CONFIG_MODE) || (BUTTON_MODE_CAPTURE == BUTTON_CONFIG_MODE)
+static TaskHandle_t button_htask_;
+/* DWT cycles of the accepted release */
+static volatile uint32_t button_release_cycles_;
+#endif
+
+#if (BUTTON_MODE_EXTI == BUTTON_CONFIG_MODE)
+static TimerHandle_t button_debounce_timer_;
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+static StaticTimer_t button_debounce_timer_buffer_;
+#endif
+
+/* 64 bit DWT cycles of the last edge and of the accepted press, a hold outlasts a CYCCNT wrap */
+static volatile uint64_t button_edge_cycles_;
+static uint64_t button_press_cycles_;
+static bool button_pressed_;
+#endif
+
+#if (BUTTON_MODE_CAPTURE == BUTTON_CONFIG_MODE)
+static TIM_HandleTypeDef button_htim_;
+#endif
+
+#if (BUTTON_MODE_SCAN == BUTTON_CONFIG_MODE)
+static const button_scan_input_t button_inputs_[BUTTON_ID__N] =
+{
+	[BUTTON_ID_A] = { BUTTON_A_PORT, BUTTON_A_PIN, BUTTON_PRESSED },
+	[BUTTON_ID_B] = { BUTTON_B_PORT, BUTTON_B_PIN, BUTTON_PRESSED },
+	[BUTTON_ID_C] = { BUTTON_C_PORT, BUTTON_C_PIN, BUTTON_PRESSED },
+};
+
+static button_scan_t button_scan_;
+static TickType_t button_press_tick_[BUTTON_ID__N];
+#endif
 
-extern SemaphoreHandle_t hsem_button;
+/********************** external data definition *****************************/
 
 /********************** internal functions definition ************************/
 
+static button_type_t button_classify_(uint32_t hold_ms)
+{
+	button_type_t ret = BUTTON_TYPE_NONE;
+	if(BUTTON_LONG_TIMEOUT_ <= hold_ms)
+	{
+		ret = BUTTON_TYPE_LONG;
+	}
+	else if(BUTTON_SHORT_TIMEOUT_ <= hold_ms)
+	{
+		ret = BUTTON_TYPE_SHORT;
+	}
+	else if(BUTTON_PULSE_TIMEOUT_ <= hold_ms)
+	{
+		ret = BUTTON_TYPE_PULSE;
+	}
+	return ret;
+}
+
+static void button_publish_(button_id_t button_id, button_type_t button_type, uint32_t read_cycles)
+{
+	uint32_t trace_id = LATENCY_TRACE_ID_NONE;
+	if(BUTTON_TYPE_NONE != button_type)
+	{
+		trace_id = latency_trace_begin(read_cycles);
+		latency_trace_stamp(trace_id, LATENCY_STAGE_BUTTON_CLASSIFY);
+	}
+
+	message_t pmsg;
+	switch (button_type)
+	{
+
+
+	case BUTTON_TYPE_NONE:
+		break;
+
+	case BUTTON_TYPE_PULSE:
+
+		LOGGER_DEBUG("Memoria alocada: %d", sizeof(message_t));
+
+		pmsg.size = sizeof(message_t);
+		pmsg.button = button_type;
+		pmsg.id = button_id;
+		pmsg.trace_id = trace_id;
+
+		LOGGER_INFO("button pulse");
+		bus_publish(BUS_SIGNAL_BUTTON, &pmsg);
+
+		break;
+
+	case BUTTON_TYPE_SHORT:
+
+		LOGGER_DEBUG("Memoria alocada: %d", sizeof(message_t));
+		pmsg.size = sizeof(message_t);
+		pmsg.button = button_type;
+		pmsg.id = button_id;
+		pmsg.trace_id = trace_id;
+
+		LOGGER_INFO("button short");
+		bus_publish(BUS_SIGNAL_BUTTON, &pmsg);
+
+		break;
+
+	case BUTTON_TYPE_LONG:
+
+		LOGGER_DEBUG("Memoria alocada: %d", sizeof(message_t));
+		pmsg.size = sizeof(message_t);
+		pmsg.button = button_type;
+		pmsg.id = button_id;
+		pmsg.trace_id = trace_id;
+		LOGGER_INFO("button long");
+		bus_publish(BUS_SIGNAL_BUTTON, &pmsg);
+
+		break;
+
+	default:
+		LOGGER_ERROR("button error");
+		break;
+	}
+}
+
+#if (BUTTON_MODE_EXTI == BUTTON_CONFIG_MODE)
+
+/* Runs in the timer service task once the pin has been quiet for BUTTON_DEBOUNCE_MS */
+static void button_debounce_expired_(TimerHandle_t htimer)
+{
+	bool pressed = (BUTTON_PRESSED == HAL_GPIO_ReadPin(BUTTON_PORT, BUTTON_PIN));
+	/* Two words written by the EXTI ISR */
+	taskENTER_CRITICAL();
+	uint64_t edge_cycles = button_edge_cycles_;
+	taskEXIT_CRITICAL();
+
+	if(pressed && !button_pressed_)
+	{
+		button_press_cycles_ = edge_cycles;
+		button_pressed_ = true;
+	}
+	else if(!pressed && button_pressed_)
+	{
+		button_pressed_ = false;
+		button_release_cycles_ = (uint32_t)edge_cycles;
+		uint64_t hold_us = (edge_cycles - button_press_cycles_) / cycles_per_us;
+		xTaskNotify(button_htask_, (UINT32_MAX < hold_us) ? UINT32_MAX : (uint32_t)hold_us, eSetValueWithOverwrite);
+	}
+}
+
+static void button_init_(void)
+{
+	button_pressed_ = false;
+	button_htask_ = xTaskGetCurrentTaskHandle();
+#if (1 == configSUPPORT_STATIC_ALLOCATION)
+	button_debounce_timer_ = xTimerCreateStatic("Button debounce", pdMS_TO_TICKS(BUTTON_DEBOUNCE_MS), pdFALSE,
+	                                            NULL, button_debounce_expired_, &button_debounce_timer_buffer_);
+#else
+	button_debounce_timer_ = xTimerCreate("Button debounce", pdMS_TO_TICKS(BUTTON_DEBOUNCE_MS), pdFALSE,
+	                                      NULL, button_debounce_expired_);
+#endif
+	configASSERT(NULL != button_debounce_timer_);
+}
+
+#elif (BUTTON_MODE_CAPTURE == BUTTON_CONFIG_MODE)
+
+/*
+ * TIM5 in PWM input mode counts microseconds. The press edge on CH1 resets the counter
+ * through the slave controller and the release edge latches it into CH2, so CCR2 is the
+ * hold time and the CPU only runs once per release.
+ */
+static void button_init_(void)
+{
+	GPIO_InitTypeDef gpio = {0};
+	TIM_IC_InitTypeDef ic = {0};
+	TIM_SlaveConfigTypeDef slave = {0};
+	HAL_StatusTypeDef status;
+	uint32_t press_polarity = (GPIO_PIN_SET == BUTTON_PRESSED) ? TIM_INPUTCHANNELPOLARITY_RISING : TIM_INPUTCHANNELPOLARITY_FALLING;
+	uint32_t release_polarity = (GPIO_PIN_SET == BUTTON_PRESSED) ? TIM_INPUTCHANNELPOLARITY_FALLING : TIM_INPUTCHANNELPOLARITY_RISING;
+
+	button_htask_ = xTaskGetCurrentTaskHandle();
+
+	__HAL_RCC_GPIOA_CLK_ENABLE();
+	__HAL_RCC_TIM5_CLK_ENABLE();
+
+	gpio.Pin = GPIO_PIN_0;
+	gpio.Mode = GPIO_MODE_AF_PP;
+	gpio.Pull = GPIO_NOPULL;
+	gpio.Speed = GPIO_SPEED_FREQ_LOW;
+	gpio.Alternate = GPIO_AF2_TIM5;
+	HAL_GPIO_Init(GPIOA, &gpio);
+
+	/* APB1 timers run at twice PCLK1 whenever APB1 is divided */
+	uint32_t tim_clock = HAL_RCC_GetPCLK1Freq();
+	if (RCC_HCLK_DIV1 != (RCC->CFGR & RCC_CFGR_PPRE1))
+	{
+		tim_clock *= 2;
+	}
+
+	/* 1 MHz, the 32 bit counter spans over an hour */
+	button_htim_.Instance = TIM5;
+	button_htim_.Init.Prescaler = (tim_clock / 1000000) - 1;
+	button_htim_.Init.CounterMode = TIM_COUNTERMODE_UP;
+	button_htim_.Init.Period = 0xFFFFFFFF;
+	button_htim_.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	button_htim_.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+	status = HAL_TIM_IC_Init(&button_htim_);
+	configASSERT(HAL_OK == status);
+
+	ic.ICPolarity = press_polarity;
+	ic.ICSelection = TIM_ICSELECTION_DIRECTTI;
+	ic.ICPrescaler = TIM_ICPSC_DIV1;
+	ic.ICFilter = 0xF;
+	status = HAL_TIM_IC_ConfigChannel(&button_htim_, &ic, TIM_CHANNEL_1);
+	configASSERT(HAL_OK == status);
+
+	ic.ICPolarity = release_polarity;
+	ic.ICSelection = TIM_ICSELECTION_INDIRECTTI;
+	status = HAL_TIM_IC_ConfigChannel(&button_htim_, &ic, TIM_CHANNEL_2);
+	configASSERT(HAL_OK == status);
+
+	slave.SlaveMode = TIM_SLAVEMODE_RESET;
+	slave.InputTrigger = TIM_TS_TI1FP1;
+	slave.TriggerPolarity = press_polarity;
+	slave.TriggerPrescaler = TIM_TRIGGERPRESCALER_DIV1;
+	slave.TriggerFilter = 0xF;
+	status = HAL_TIM_SlaveConfigSynchro(&button_htim_, &slave);
+	configASSERT(HAL_OK == status);
+
+	HAL_NVIC_SetPriority(TIM5_IRQn, 5, 0);
+	HAL_NVIC_EnableIRQ(TIM5_IRQn);
+
+	HAL_TIM_IC_Start(&button_htim_, TIM_CHANNEL_1);
+	HAL_TIM_IC_Start_IT(&button_htim_, TIM_CHANNEL_2);
+}
+
+#elif (BUTTON_MODE_SCAN == BUTTON_CONFIG_MODE)
+
+static void button_init_(void)
+{
+	bool ok = button_scan_init(&button_scan_, button_inputs_, BUTTON_ID__N);
+	configASSERT(ok);
+	(void)ok;
+}
+
+#else
+
 static struct
 {
 	uint32_t counter;
@@ -86,86 +325,132 @@ static button_type_t button_process_state_(bool value)
 	}
 	else
 	{
-		if(BUTTON_LONG_TIMEOUT_ <= button.counter)
-		{
-			ret = BUTTON_TYPE_LONG;
-		}
-		else if(BUTTON_SHORT_TIMEOUT_ <= button.counter)
-		{
-			ret = BUTTON_TYPE_SHORT;
-		}
-		else if(BUTTON_PULSE_TIMEOUT_ <= button.counter)
-		{
-			ret = BUTTON_TYPE_PULSE;
-		}
+		ret = button_classify_(button.counter);
 		button.counter = 0;
 	}
 	return ret;
 }
 
+#endif
 
 /********************** external functions definition ************************/
 
-void task_button(void* argument)
-{
-	button_init_();
+#if (BUTTON_MODE_EXTI == BUTTON_CONFIG_MODE)
 
-	while(true)
+/* Both edges of the button pin: timestamp the edge and restart the debounce window */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	if((BUTTON_PIN != GPIO_Pin) || (NULL == button_debounce_timer_))
 	{
-		GPIO_PinState button_state;
-		button_state = HAL_GPIO_ReadPin(BUTTON_PORT, BUTTON_PIN);
+		return;
+	}
 
-		button_type_t button_type;
-		button_type = button_process_state_(button_state);
+	BaseType_t higher_priority_task_woken = pdFALSE;
+	button_edge_cycles_ = cycle_counter_get64();
+	xTimerResetFromISR(button_debounce_timer_, &higher_priority_task_woken);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
 
-		message_t pmsg;
-		switch (button_type)
-		{
+#elif (BUTTON_MODE_CAPTURE == BUTTON_CONFIG_MODE)
 
+/* Release edge captured: CCR2 holds the hold time in microseconds */
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
+{
+	if((&button_htim_ != htim) || (HAL_TIM_ACTIVE_CHANNEL_2 != htim->Channel))
+	{
+		return;
+	}
+
+	uint32_t hold_us = HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_2);
+	/* Contact bounce, the press edge that follows restarts the measure */
+	if(hold_us < (BUTTON_DEBOUNCE_MS * 1000))
+	{
+		return;
+	}
 
-		case BUTTON_TYPE_NONE:
-			break;
+	BaseType_t higher_priority_task_woken = pdFALSE;
+	button_release_cycles_ = cycle_counter_get();
+	xTaskNotifyFromISR(button_htask_, hold_us, eSetValueWithOverwrite, &higher_priority_task_woken);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
 
-		case BUTTON_TYPE_PULSE:
+void button_capture_irq_handler(void)
+{
+	HAL_TIM_IRQHandler(&button_htim_);
+}
 
-			LOGGER_INFO("Memoria alocada: %d", sizeof(message_t));
+#endif
 
-			pmsg.size = sizeof(message_t);
-			pmsg.button = button_type;
+#if (BUTTON_MODE_EXTI == BUTTON_CONFIG_MODE) || (BUTTON_MODE_CAPTURE == BUTTON_CONFIG_MODE)
 
-			LOGGER_INFO("button pulse");
-			ui_send_message(&pmsg);
+void task_button(void* argument)
+{
+	button_init_();
 
-			break;
+	while(true)
+	{
+		uint32_t hold_us;
+		if(pdPASS == xTaskNotifyWait(0, 0, &hold_us, portMAX_DELAY))
+		{
+			button_publish_(BUTTON_ID_A, button_classify_(hold_us / 1000), button_release_cycles_);
+		}
+	}
+}
 
-		case BUTTON_TYPE_SHORT:
+#elif (BUTTON_MODE_SCAN == BUTTON_CONFIG_MODE)
 
-			LOGGER_INFO("Memoria alocada: %d", sizeof(message_t));
-			pmsg.size = sizeof(message_t);
-			pmsg.button = button_type;
+void task_button(void* argument)
+{
+	button_init_();
 
-			LOGGER_INFO("button short");
-			ui_send_message(&pmsg);
+	TickType_t last_wake = xTaskGetTickCount();
+	while(true)
+	{
+		uint32_t changed = button_scan_update(&button_scan_);
+		if(0 != changed)
+		{
+			uint32_t read_cycles = cycle_counter_get();
+			TickType_t now = xTaskGetTickCount();
+			for(button_id_t id = 0; id < BUTTON_ID__N; ++id)
+			{
+				if(!button_scan_input_changed(&button_scan_, changed, id))
+				{
+					continue;
+				}
+				if(button_scan_input_pressed(&button_scan_, id))
+				{
+					button_press_tick_[id] = now;
+				}
+				else
+				{
+					uint32_t hold_ms = (uint32_t)(now - button_press_tick_[id]) * portTICK_PERIOD_MS;
+					button_publish_(id, button_classify_(hold_ms), read_cycles);
+				}
+			}
+		}
 
-			break;
+		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(BUTTON_SCAN_PERIOD_MS));
+	}
+}
 
-		case BUTTON_TYPE_LONG:
+#else
 
-			LOGGER_INFO("Memoria alocada: %d", sizeof(message_t));
-			pmsg.size = sizeof(message_t);
-			pmsg.button = button_type;
-			LOGGER_INFO("button long");
-			ui_send_message(&pmsg);
+void task_button(void* argument)
+{
+	button_init_();
 
-			break;
+	while(true)
+	{
+		GPIO_PinState button_state;
+		button_state = HAL_GPIO_ReadPin(BUTTON_PORT, BUTTON_PIN);
+		uint32_t read_cycles = cycle_counter_get();
 
-		default:
-			LOGGER_INFO("button error");
-			break;
-		}
+		button_publish_(BUTTON_ID_A, button_process_state_(button_state), read_cycles);
 
 		vTaskDelay((TickType_t)(TASK_PERIOD_MS_ / portTICK_PERIOD_MS));
 	}
 }
 
+#endif
+
 /********************** end of file ******************************************/
@@ -0,0 +1,119 @@
+# Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+# All rights reserved. BSD 3-Clause, see the C sources for the full text.
+#
+# @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+
+"""Minimal ELF reader for the host tools, standard library only.
+
+Reads section headers and the symbol table of 32 and 64 bit little endian ELF files,
+which covers the arm-none-eabi firmware image.
+"""
+
+import struct
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+STT_FUNC = 2
+
+
+class Section:
+    def __init__(self, name, type_, flags, addr, offset, size, link, entsize):
+        self.name = name
+        self.type = type_
+        self.flags = flags
+        self.addr = addr
+        self.offset = offset
+        self.size = size
+        self.link = link
+        self.entsize = entsize
+
+
+class Symbol:
+    def __init__(self, name, value, size, type_):
+        self.name = name
+        self.value = value
+        self.size = size
+        self.type = type_
+
+
+class Elf:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+        if self.data[5] != 1:
+            raise ValueError("%s is not little endian" % path)
+        self.is64 = self.data[4] == 2
+        self._read_sections()
+
+    def _read_sections(self):
+        if self.is64:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x3A)
+            fmt = "<IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x2E)
+            fmt = "<IIIIIIIIII"
+
+        raw = []
+        for i in range(shnum):
+            raw.append(struct.unpack_from(fmt, self.data, shoff + i * shentsize))
+
+        names = raw[shstrndx]
+        self.sections = []
+        for (name, type_, flags, addr, offset, size, link, _info, _align, entsize) in raw:
+            self.sections.append(Section(self._cstr(names[4] + name), type_, flags, addr,
+                                         offset, size, link, entsize))
+
+    def _cstr(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("utf-8", "replace")
+
+    def section(self, name):
+        for s in self.sections:
+            if s.name == name:
+                return s
+        return None
+
+    def section_data(self, section):
+        if section.type == SHT_NOBITS:
+            return b"\0" * section.size
+        return self.data[section.offset:section.offset + section.size]
+
+    def read(self, addr, size):
+        """Bytes at a load address, None when no allocated section holds them."""
+        for s in self.sections:
+            if (s.flags & SHF_ALLOC) and s.type != SHT_NOBITS and s.addr <= addr and addr + size <= s.addr + s.size:
+                start = s.offset + addr - s.addr
+                return self.data[start:start + size]
+        return None
+
+    def read_cstr(self, addr, limit=256):
+        """NUL terminated string at a load address, None when it is not in the image."""
+        for s in self.sections:
+            if (s.flags & SHF_ALLOC) and s.type != SHT_NOBITS and s.addr <= addr < s.addr + s.size:
+                start = s.offset + addr - s.addr
+                end = min(s.offset + s.size, start + limit)
+                chunk = self.data[start:end]
+                return chunk.split(b"\0", 1)[0].decode("utf-8", "replace")
+        return None
+
+    def symbols(self):
+        symtab = self.section(".symtab")
+        if symtab is None:
+            return []
+        strtab = self.sections[symtab.link]
+        entsize = symtab.entsize or (24 if self.is64 else 16)
+        out = []
+        for off in range(symtab.offset, symtab.offset + symtab.size, entsize):
+            if self.is64:
+                name, info, _other, _shndx, value, size = struct.unpack_from("<IBBHQQ", self.data, off)
+            else:
+                name, value, size, info, _other, _shndx = struct.unpack_from("<IIIBBH", self.data, off)
+            if name:
+                out.append(Symbol(self._cstr(strtab.offset + name), value, size, info & 0xF))
+        return out
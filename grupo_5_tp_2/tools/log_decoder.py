@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+# All rights reserved. BSD 3-Clause, see the C sources for the full text.
+#
+# @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+
+"""Decodes the tokenized log stream (LOGGER_CONFIG_TOKENIZED) back into text.
+
+Record, little endian: sync 0xA5 (u8), nargs (u8), id (u32), DWT cycles (u32),
+nargs argument words (u32). The id is the offset of the format string in the
+.logstr section of the firmware ELF. Plain text lines between records, like the
+crash report header, are passed through.
+
+    tools/log_decoder.py Debug/grupo_5_tp_2.elf capture.bin
+    tools/log_decoder.py Debug/grupo_5_tp_2.elf - < /dev/ttyACM0
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+from elfutil import Elf
+
+SYNC = 0xA5
+MAX_ARGS = 8
+HEADER_LEN = 10
+MAX_TEXT = 256      # Longest plain text line kept while looking for its end
+
+# %[flags][width][.precision][length]conversion
+SPEC = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t)?([diuxXcspo%])")
+
+
+def to_signed(word):
+    return word - (1 << 32) if word & 0x80000000 else word
+
+
+def format_c(fmt, args, elf):
+    """printf subset over 32 bit argument words."""
+    out = []
+    pos = 0
+    args = list(args)
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, _length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if width == "*":
+            width = str(to_signed(args.pop(0))) if args else ""
+        if precision == "*":
+            precision = str(to_signed(args.pop(0))) if args else ""
+        if not args:
+            out.append("<missing>")
+            continue
+        word = args.pop(0)
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+        if conv in "di":
+            out.append((spec + "d") % to_signed(word))
+        elif conv == "u":
+            out.append((spec + "d") % word)
+        elif conv in "xXo":
+            out.append((spec + conv) % word)
+        elif conv == "c":
+            out.append((spec + "c") % chr(word & 0xFF))
+        elif conv == "p":
+            out.append("0x%08x" % word)
+        elif conv == "s":
+            text = elf.read_cstr(word)
+            out.append((spec + "s") % (text if text is not None else "<0x%08x>" % word))
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def text_lines(skipped):
+    """Splits the complete lines off the bytes skipped between records, keeps the printable ones."""
+    *lines, rest = skipped.split(b"\n")
+    text = [line.decode("ascii") + "\n" for line in lines
+            if line and all(32 <= c < 127 or c in b"\t\r" for c in line)]
+    return text, rest[-MAX_TEXT:]
+
+
+def decode(stream, strings, elf, clock_hz):
+    """Yields (seconds, text), resynchronizing on the next sync byte after garbage."""
+    buf = b""
+    skipped = b""
+    epoch = None
+    last = 0
+    wraps = 0
+    seconds = 0.0
+    while True:
+        chunk = stream.read(4096)
+        if chunk:
+            buf += chunk
+        while True:
+            start = buf.find(bytes([SYNC]))
+            if start < 0:
+                skipped += buf
+                buf = b""
+            else:
+                skipped += buf[:start]
+                buf = buf[start:]
+            # Text written as is, stamped with the time of the record before it
+            text, skipped = text_lines(skipped)
+            for line in text:
+                yield seconds, line
+            if len(buf) < HEADER_LEN:
+                break
+            nargs = buf[1]
+            token, cycles = struct.unpack_from("<II", buf, 2)
+            if nargs > MAX_ARGS or token not in strings:
+                skipped += buf[:1]
+                buf = buf[1:]
+                continue
+            length = HEADER_LEN + 4 * nargs
+            if len(buf) < length:
+                break
+            args = struct.unpack_from("<%dI" % nargs, buf, HEADER_LEN)
+            buf = buf[length:]
+
+            # CYCCNT wraps every 2^32 cycles, keep a running time across wraps
+            if epoch is None:
+                epoch = cycles
+            elif cycles < last:
+                wraps += 1
+            last = cycles
+            seconds = ((wraps << 32) + cycles - epoch) / clock_hz
+            yield seconds, format_c(strings[token], args, elf)
+        if not chunk:
+            return
+
+
+def load_strings(elf):
+    section = elf.section(".logstr")
+    if section is None:
+        raise SystemExit("no .logstr section, build with LOGGER_CONFIG_TOKENIZED (1)")
+    data = elf.section_data(section)
+    strings = {}
+    offset = 0
+    while offset < len(data):
+        end = data.find(b"\0", offset)
+        if end < 0:
+            break
+        if end > offset:
+            strings[section.addr + offset] = data[offset:end].decode("utf-8", "replace")
+        offset = end + 1
+    return strings
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF built with LOGGER_CONFIG_TOKENIZED (1)")
+    parser.add_argument("input", help="captured stream, - for stdin")
+    parser.add_argument("--clock-hz", type=float, default=168e6, help="core clock, default 168 MHz")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    strings = load_strings(elf)
+    stream = sys.stdin.buffer if args.input == "-" else open(args.input, "rb")
+    for seconds, text in decode(stream, strings, elf, args.clock_hz):
+        sys.stdout.write("[%12.6f] %s" % (seconds, text if text.endswith("\n") else text + "\n"))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+# All rights reserved. BSD 3-Clause, see the C sources for the full text.
+#
+# @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+
+"""Turns a PC sampler dump (pc_sampler.h) into a flat profile.
+
+Each sampled PC is resolved to the function around it with the firmware ELF.
+The default output is a flat profile, one line per function with its share of
+the task samples. --folded prints "task;function count" lines instead, which
+flamegraph.pl, speedscope or inferno take as they are.
+
+    (gdb) dump binary value pcs.bin pc_sampler
+    tools/pc_profile.py Debug/grupo_5_tp_2.elf pcs.bin
+    tools/pc_profile.py Debug/grupo_5_tp_2.elf pcs.bin --folded > pcs.folded
+"""
+
+import argparse
+import bisect
+import collections
+import struct
+import sys
+
+from elfutil import Elf, STT_FUNC
+
+MAGIC = 0x4D534350
+VERSION = 1
+HEADER = struct.Struct("<IHHIIIIIIHH")
+ENTRY = struct.Struct("<IHHI")
+
+
+class Samples:
+    def __init__(self, data):
+        (magic, version, entry_size, capacity, self.rate_hz, self.samples, self.handler,
+         self.startup, self.dropped, names, name_len) = HEADER.unpack_from(data, 0)
+        if magic != MAGIC:
+            raise ValueError("not a PC sampler dump, magic 0x%08X" % magic)
+        if version != VERSION or entry_size != ENTRY.size:
+            raise ValueError("unsupported sampler version %d, entry size %d" % (version, entry_size))
+
+        offset = HEADER.size
+        self.names = {}
+        for i in range(names):
+            name = data[offset:offset + name_len].split(b"\0", 1)[0].decode("ascii", "replace")
+            if name:
+                self.names[i] = name
+            offset += name_len
+        self.name_slots = names
+
+        # C pads the entry array up to its alignment
+        offset = (offset + 3) & ~3
+        self.entries = []
+        for i in range(capacity):
+            pc, task, _reserved, count = ENTRY.unpack_from(data, offset + i * ENTRY.size)
+            if pc and count:
+                self.entries.append((pc, task, count))
+
+    def task_name(self, number):
+        return self.names.get(number % self.name_slots, "task %d" % number)
+
+
+class Symbols:
+    def __init__(self, elf):
+        functions = {}
+        for sym in elf.symbols():
+            if sym.type == STT_FUNC and sym.size:
+                # Thumb functions have bit 0 set in their symbol value
+                functions.setdefault(sym.value & ~1, (sym.size, sym.name))
+        self.starts = sorted(functions)
+        self.functions = [functions[start] for start in self.starts]
+
+    def lookup(self, pc):
+        pc &= ~1
+        i = bisect.bisect_right(self.starts, pc) - 1
+        if i >= 0:
+            size, name = self.functions[i]
+            if pc < self.starts[i] + size:
+                return name
+        return "0x%08x" % pc
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF the dump was taken from")
+    parser.add_argument("input", help="binary dump of pc_sampler")
+    parser.add_argument("--folded", action="store_true", help="task;function count lines for flame graphs")
+    parser.add_argument("--top", type=int, default=40, help="functions in the flat profile, 0 for all")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        samples = Samples(f.read())
+    symbols = Symbols(Elf(args.elf))
+
+    by_function = collections.Counter()
+    by_stack = collections.Counter()
+    for pc, task, count in samples.entries:
+        function = symbols.lookup(pc)
+        by_function[function] += count
+        by_stack["%s;%s" % (samples.task_name(task), function)] += count
+
+    if samples.dropped:
+        sys.stderr.write("histogram full, %d samples dropped\n" % samples.dropped)
+
+    if args.folded:
+        for stack, count in sorted(by_stack.items()):
+            print("%s %d" % (stack.replace(" ", "_"), count))
+        return
+
+    total = sum(by_function.values())
+    print("%d samples at %d Hz, %.1f s: %d in tasks, %d in other ISRs, %d before the scheduler, %d dropped"
+          % (samples.samples, samples.rate_hz, samples.samples / max(samples.rate_hz, 1),
+             total, samples.handler, samples.startup, samples.dropped))
+    print("%8s %7s  %s" % ("samples", "share", "function"))
+    ranked = by_function.most_common(args.top or None)
+    for function, count in ranked:
+        print("%8d %6.2f%%  %s" % (count, 100.0 * count / max(total, 1), function))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : rta.c
+ * @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+ */
+
+/*
+ * Host side response time analysis of APP_TASK_TABLE (fixed priority, preemptive).
+ *
+ *   gcc -I../app/inc rta.c -o rta && ./rta
+ *
+ * Exits with 1 when a task misses its deadline or the button to LED chain
+ * does not fit in APP_BUTTON_TO_LED_DEADLINE_MS.
+ */
+
+/********************** inclusions *******************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "app_task_table.h"
+
+/********************** macros and definitions *******************************/
+
+#define RTA_ROW_(id, name, period_ms, wcet_us, priority, stack_words, placement)\
+  { #id, (name), (uint64_t)(period_ms) * 1000u, (wcet_us), (priority) },
+
+#define RTA_CHAIN_(id)        APP_TASK_ID_##id,
+
+/********************** internal data declaration ****************************/
+
+typedef struct
+{
+  const char* id;
+  const char* name;
+  uint64_t period_us;
+  uint64_t wcet_us;
+  unsigned priority;
+} rta_task_t;
+
+/********************** internal data definition *****************************/
+
+static const rta_task_t tasks_[APP_TASK__N] =
+{
+  APP_TASK_TABLE(RTA_ROW_)
+};
+
+static const app_task_id_t chain_[] =
+{
+  APP_BUTTON_TO_LED_CHAIN(RTA_CHAIN_)
+};
+
+/********************** internal functions definition ************************/
+
+static uint64_t ceil_div_(uint64_t a, uint64_t b)
+{
+  return (a + b - 1) / b;
+}
+
+/* R = C + sum(ceil(R / Tj) * Cj) over every other task of higher or equal priority */
+static bool rta_response_time_(size_t i, uint64_t* presponse)
+{
+  const rta_task_t* ptask = &tasks_[i];
+  uint64_t response = ptask->wcet_us;
+
+  while(true)
+  {
+    uint64_t next = ptask->wcet_us;
+    for(size_t j = 0; j < APP_TASK__N; ++j)
+    {
+      if((j != i) && (tasks_[j].priority >= ptask->priority))
+      {
+        next += ceil_div_(response, tasks_[j].period_us) * tasks_[j].wcet_us;
+      }
+    }
+    if(next > ptask->period_us)
+    {
+      *presponse = next;
+      return false;
+    }
+    if(next == response)
+    {
+      *presponse = response;
+      return true;
+    }
+    response = next;
+  }
+}
+
+/********************** external functions definition ************************/
+
+int main(void)
+{
+  uint64_t response[APP_TASK__N];
+  bool ok = true;
+  double utilization = 0.0;
+
+  printf("%-12s %-14s %4s %10s %10s %12s  %s\n", "id", "name", "prio", "period_us", "wcet_us", "response_us", "result");
+  for(size_t i = 0; i < APP_TASK__N; ++i)
+  {
+    bool schedulable = rta_response_time_(i, &response[i]);
+    ok = ok && schedulable;
+    utilization += (double)tasks_[i].wcet_us / (double)tasks_[i].period_us;
+    printf("%-12s %-14s %4u %10llu %10llu %12llu  %s\n", tasks_[i].id, tasks_[i].name, tasks_[i].priority,
+           (unsigned long long)tasks_[i].period_us, (unsigned long long)tasks_[i].wcet_us,
+           (unsigned long long)response[i], schedulable ? "ok" : "DEADLINE MISS");
+  }
+  printf("utilization: %.2f %%\n", utilization * 100.0);
+
+  /* The release is sampled up to one button period late, then every stage runs once */
+  uint64_t chain_us = tasks_[APP_TASK_ID_BUTTON].period_us;
+  for(size_t i = 0; i < (sizeof(chain_) / sizeof(chain_[0])); ++i)
+  {
+    chain_us += response[chain_[i]];
+  }
+  bool chain_ok = chain_us <= ((uint64_t)APP_BUTTON_TO_LED_DEADLINE_MS * 1000u);
+  printf("button to LED: %llu us, deadline %u ms, %s\n", (unsigned long long)chain_us,
+         (unsigned)APP_BUTTON_TO_LED_DEADLINE_MS, chain_ok ? "ok" : "DEADLINE MISS");
+
+  return (ok && chain_ok) ? 0 : 1;
+}
+
+/********************** end of file ******************************************/
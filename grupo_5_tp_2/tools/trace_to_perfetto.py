@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+# Copyright (c) 2023 Sebastian Bedin <sebabedin@gmail.com>.
+# All rights reserved. BSD 3-Clause, see the C sources for the full text.
+#
+# @authors : Abraham Rodriguez, Estanislao Crivos, Jose Roberto Castro
+
+"""Turns a kernel trace dump (kernel_trace.h) into Chrome trace JSON.
+
+The output opens in https://ui.perfetto.dev or chrome://tracing: one track per
+task with its running slices, queue sends and receives as instants on the task
+(or ISR) that made them, and blocking on a queue as an instant named after it.
+
+    (gdb) dump binary value trace.bin kernel_trace
+    tools/trace_to_perfetto.py trace.bin > trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x4352544B
+VERSION = 1
+HEADER = struct.Struct("<IHHIIIHHQ")
+RECORD = struct.Struct("<IBBH")
+
+FLAG_ISR = 0x01
+
+(EVENT_GAP,
+ EVENT_TASK_SWITCHED_IN,
+ EVENT_TASK_SWITCHED_OUT,
+ EVENT_TASK_CREATE,
+ EVENT_TASK_DELETE,
+ EVENT_QUEUE_CREATE,
+ EVENT_QUEUE_SEND,
+ EVENT_QUEUE_RECEIVE,
+ EVENT_QUEUE_BLOCK_SEND,
+ EVENT_QUEUE_BLOCK_RECEIVE) = range(10)
+
+PID = 1
+ISR_TID = 0                     # Tasks are numbered from 1
+
+
+class Trace:
+    def __init__(self, data):
+        (magic, version, record_size, capacity, written, clock_hz,
+         names, name_len, base) = HEADER.unpack_from(data, 0)
+        if magic != MAGIC:
+            raise ValueError("not a kernel trace dump, magic 0x%08X" % magic)
+        if version != VERSION or record_size != RECORD.size:
+            raise ValueError("unsupported trace version %d, record size %d" % (version, record_size))
+
+        self.clock_hz = clock_hz
+        offset = HEADER.size
+        self.names = {}
+        for i in range(names):
+            name = data[offset:offset + name_len].split(b"\0", 1)[0].decode("ascii", "replace")
+            if name:
+                self.names[i] = name
+            offset += name_len
+        self.name_slots = names
+
+        # Oldest first, once wrapped the oldest record sits right after the newest one
+        count = min(written, capacity)
+        first = written - count
+        self.records = []
+        for n in range(first, written):
+            self.records.append(RECORD.unpack_from(data, offset + (n % capacity) * RECORD.size))
+        self.base = base
+        self.lost = first
+
+    def task_name(self, number):
+        return self.names.get(number % self.name_slots, "task %d" % number)
+
+
+def to_events(trace, clock_hz):
+    events = []
+    seen_tasks = set()
+    running = None
+    running_since = 0.0
+    cycles = trace.base
+
+    def us(c):
+        return (c - trace.base) * 1e6 / clock_hz
+
+    def instant(name, tid, ts, args=None):
+        event = {"name": name, "ph": "i", "s": "t", "pid": PID, "tid": tid, "ts": ts}
+        if args:
+            event["args"] = args
+        events.append(event)
+
+    for delta, event, flags, obj in trace.records:
+        cycles += delta
+        ts = us(cycles)
+        if event == EVENT_GAP:
+            continue
+
+        if event in (EVENT_TASK_SWITCHED_IN, EVENT_TASK_SWITCHED_OUT, EVENT_TASK_CREATE, EVENT_TASK_DELETE):
+            seen_tasks.add(obj)
+
+        if event == EVENT_TASK_SWITCHED_IN:
+            running, running_since = obj, ts
+        elif event == EVENT_TASK_SWITCHED_OUT:
+            if running == obj:
+                events.append({"name": trace.task_name(obj), "ph": "X", "pid": PID, "tid": obj,
+                               "ts": running_since, "dur": ts - running_since})
+            running = None
+        elif event == EVENT_TASK_CREATE:
+            instant("create", obj, ts)
+        elif event == EVENT_TASK_DELETE:
+            instant("delete", obj, ts)
+        else:
+            tid = ISR_TID if (flags & FLAG_ISR) else (running if running is not None else ISR_TID)
+            name = {
+                EVENT_QUEUE_CREATE: "create queue %d",
+                EVENT_QUEUE_SEND: "send queue %d",
+                EVENT_QUEUE_RECEIVE: "receive queue %d",
+                EVENT_QUEUE_BLOCK_SEND: "block sending to queue %d",
+                EVENT_QUEUE_BLOCK_RECEIVE: "block receiving from queue %d",
+            }.get(event, "event %d on %%d" % event) % obj
+            instant(name, tid, ts, {"queue": obj})
+
+    if running is not None:
+        events.append({"name": trace.task_name(running), "ph": "X", "pid": PID, "tid": running,
+                       "ts": running_since, "dur": us(cycles) - running_since})
+
+    events.append({"name": "process_name", "ph": "M", "pid": PID, "args": {"name": "STM32F429"}})
+    events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": ISR_TID, "args": {"name": "ISR"}})
+    for number in sorted(seen_tasks):
+        events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": number,
+                       "args": {"name": trace.task_name(number)}})
+        events.append({"name": "thread_sort_index", "ph": "M", "pid": PID, "tid": number,
+                       "args": {"sort_index": number}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="binary dump of kernel_trace")
+    parser.add_argument("--clock-hz", type=float, help="core clock, defaults to the one in the dump")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        trace = Trace(f.read())
+    clock_hz = args.clock_hz or trace.clock_hz or 168e6
+    if trace.lost:
+        sys.stderr.write("ring wrapped, the %d oldest records are gone\n" % trace.lost)
+
+    json.dump({"traceEvents": to_events(trace, clock_hz), "displayTimeUnit": "ns"}, sys.stdout)
+    sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()